@@ -3,16 +3,33 @@
 #include <frc/smartdashboard/SmartDashboard.h>
 #include <frc/XboxController.h>
 #include <frc/Joystick.h>
+#include <frc/RobotController.h>
 
+#include "BallCounter.h"
+#include "CalibrationLogger.h"
+#include "CANTelemetry.h"
+#include "ClimbSequence.h"
+#include "ChassisVelocityEstimator.h"
 #include "Climber.h"
+#include "DigitalEdge.h"
 #include "Intake.h"
 #include "Launcher.h"
 #include "Limelight.h"
+#include "LoopProfiler.h"
 #include "NavX.h"
 #include "Robot.h"
 #include "RobotMap.h"
+#include "SensorSampler.h"
+#include "ShotCompensator.h"
 #include "SwerveTrain.h"
+#include "TelemetryLogger.h"
 #include "Controller.h"
+#include "DashboardChooser.h"
+#include "DashboardPublisher.h"
+#include "DriveController.h"
+#include "GalacticSearch.h"
+#include "DashboardTunable.h"
+#include "DriverInputs.h"
 
 // Auto
 #include "auto/AutoStep.h"
@@ -23,13 +40,25 @@
 #include "auto/steps/RunPrerecorded.h"
 #include "auto/steps/SetLauncherRPM.h"
 #include "auto/steps/SetIndexSpeed.h"
+#include "auto/steps/ShootSequence.h"
 #include "auto/steps/AimLauncher.h"
 #include "auto/steps/WaitSeconds.h"
 #include "auto/steps/LimelightLock.h"
+#include "auto/steps/RunGalacticSearch.h"
 #include "auto/Recorder.h"
 
+// Simulation
+#include "sim/RobotSimulation.h"
+
+//Constructed first, as the CAN telemetry and the recorder publish through it.
+DashboardPublisher dashboard;
+LoopProfiler profiler(dashboard);
+CalibrationLogger calibrationLogger(R_launcherCalibrationLogPath);
+CANTelemetry canTelemetry(dashboard);
 Climber climber(R_CANIDMotorClimberForward, R_CANIDMotorClimberRear, R_PWMPortClimberMotorTranslate, R_PWMPortClimberMotorWheel, R_PWMPortClimberServoLock, R_DIOPortSwitchClimberBottom);
 frc::DigitalInput switchSwerveUnlock(R_DIOPortSwitchSwerveUnlock);
+//Reads true while pressed, unlike the limit switches.
+DigitalEdge swerveUnlock(switchSwerveUnlock, false);
 frc::XboxController *playerOne;
 frc::XboxController *playerTwo;
 frc::Joystick *playerThree;
@@ -37,7 +66,7 @@ Intake intake(R_CANIDMotorIntake);
 Launcher launcher(R_CANIDMotorLauncherIndex, R_CANIDMotorLauncherLaunchOne, R_CANIDMotorLauncherLaunchTwo, R_PWMPortRightServo, R_PWMPortLeftServo);
 Limelight limelight;
 NavX navX(NavX::ConnectionType::kMXP);
-Recorder recorder;
+Recorder recorder(dashboard);
 SwerveTrain zion(
     R_CANIDZionFrontRightDrive,
     R_CANIDZionFrontRightSwerve,
@@ -49,7 +78,50 @@ SwerveTrain zion(
     R_CANIDZionRearRightSwerve,
     navX
 );
+//Owns Zion's output except inside a DriveController::Direct.
+DriveController driveController(zion, dashboard);
+//Every sensor the control code reads, sampled together. See SensorSampler.h.
+BallCounter ballCounter(intake, launcher);
+SensorSampler sensors(zion, navX, limelight, climber, swerveUnlock, ballCounter);
+ChassisVelocityEstimator chassisVelocity(sensors);
+ClimbSequence climbSequence(climber, sensors, dashboard);
+ShotCompensator shotCompensator(sensors, chassisVelocity);
+GalacticSearch galacticSearch(limelight, sensors);
 AutoSequence masterAuto(false);
+RobotSimulation simulation;
+
+//Everything logged to the USB stick every loop. See TelemetryLogger.h.
+TelemetryLogger telemetry;
+TelemetrySignal telemetryBattery(telemetry, "Robot::Battery");
+TelemetrySignal telemetryDropped(telemetry, "Telemetry::Dropped");
+TelemetrySignal telemetryYaw(telemetry, "NavX::Yaw");
+TelemetrySignal telemetryYawRate(telemetry, "NavX::YawRate");
+TelemetrySignal telemetryTargetCaptureYaw(telemetry, "Limelight::CaptureYaw");
+TelemetrySignal telemetryDrivePosition(telemetry, "Zion::FrontRight::DrivePosition");
+TelemetrySignal telemetryVelocityI(telemetry, "Zion::Velocity::i");
+TelemetrySignal telemetryVelocityJ(telemetry, "Zion::Velocity::j");
+TelemetrySignal telemetryDriveX(telemetry, "Zion::Drive::x");
+TelemetrySignal telemetryDriveY(telemetry, "Zion::Drive::y");
+TelemetrySignal telemetryDriveZ(telemetry, "Zion::Drive::z");
+TelemetrySignal telemetryLaunchRPM(telemetry, "Launcher::RPM");
+TelemetrySignal telemetryIndexCurrent(telemetry, "Launcher::IndexCurrent");
+TelemetrySignal telemetryTargetVisible(telemetry, "Limelight::tv");
+TelemetrySignal telemetryTargetX(telemetry, "Limelight::tx");
+TelemetrySignal telemetryTargetY(telemetry, "Limelight::ty");
+TelemetrySignal telemetryTargetArea(telemetry, "Limelight::ta");
+TelemetrySignal telemetryGalacticSearchPath(telemetry, "GalacticSearch::Path");
+TelemetrySignal telemetryGalacticSearchLatency(telemetry, "GalacticSearch::Latency");
+TelemetrySignal telemetryBallCount(telemetry, "Magazine::Count");
+TelemetrySignal telemetryClimberAtBottom(telemetry, "Climber::AtBottom");
+TelemetrySignal telemetryClimberBottomCuts(telemetry, "Climber::BottomCuts");
+
+DashboardNumber dashboardBallCount(dashboard, "Magazine::Count", R_dashboardFlushPeriod);
+DashboardNumber dashboardDrivePositions[4] = {
+    DashboardNumber(dashboard, "Zion::FrontRight::DrivePosition", R_dashboardDebugPeriod),
+    DashboardNumber(dashboard, "Zion::FrontLeft::DrivePosition", R_dashboardDebugPeriod),
+    DashboardNumber(dashboard, "Zion::RearLeft::DrivePosition", R_dashboardDebugPeriod),
+    DashboardNumber(dashboard, "Zion::RearRight::DrivePosition", R_dashboardDebugPeriod)
+};
 
 void Robot::RobotInit() {
 
@@ -66,6 +138,10 @@ void Robot::RobotInit() {
     m_speedLauncherLaunch   = 0;
     m_servoPosition         = 0;
     m_swerveBrake           = false;
+    m_calibrationShotWasMarked = false;
+    m_calibrationLaunchSpeed = 0;
+    m_autoComplete = false;
+    m_swerveUnlockPresses = 0;
 
     m_chooserAuto = new frc::SendableChooser<std::string>;
     m_chooserAuto->AddOption("Chooser::Auto::If-We-Gotta-Do-It", "dotl");
@@ -73,209 +149,300 @@ void Robot::RobotInit() {
     m_chooserAuto->AddOption("Chooser::Auto::Path A Non-Pre-recorded", "Path A Non-Pre-recorded");
     m_chooserAuto->AddOption("Chooser::Auto::Path A Recorded and shoot", "Path A Recorded and shoot");
     m_chooserAuto->AddOption("Chooser::Auto::Path B Recorded", "Path B Recorded");
+    m_chooserAuto->AddOption("Chooser::Auto::Galactic Search", "Galactic Search");
     m_chooserAuto->AddOption("Chooser::Auto::AutoNav Challenge::Barrel Racing Path", "brp");
     m_chooserAuto->AddOption("Chooser::Auto::AutoNav Challenge::Slalom Path", "sp");
     m_chooserAuto->AddOption("Chooser::Auto::AutoNav Challenge::Bounce Path", "bp");
     m_chooserAuto->AddOption("Chooser::Auto::Launch Power Cells", "Launch Power Cells");
     m_chooserAuto->SetDefaultOption("Chooser::Auto::Test Pre-recorded", "test pre-recorded");
-    frc::SmartDashboard::PutData(m_chooserAuto);
+    m_selectionAuto = new DashboardChooser("Chooser::Auto", m_chooserAuto);
 
     m_chooserController = new frc::SendableChooser<std::string>;
     m_chooserController->AddOption("Chooser::Controller::XboxController", "XboxController");
     m_chooserController->SetDefaultOption("Chooser::Controller::Joystick", "Joystick");
-    frc::SmartDashboard::PutData(m_chooserController);
+    m_selectionController = new DashboardChooser("Chooser::Controller", m_chooserController);
+    m_useXboxController = false;
 
-    frc::SmartDashboard::PutNumber("Field::Launcher::Speed-Index:", R_launcherDefaultSpeedIndex);
-    frc::SmartDashboard::PutNumber("Field::Launcher::Speed-Launcher", R_launcherDefaultSpeed);
+    m_tunableSpeedIndex = new DashboardTunable("Field::Launcher::Speed-Index:", R_launcherDefaultSpeedIndex);
+    m_tunableSpeedLauncher = new DashboardTunable("Field::Launcher::Speed-Launcher", R_launcherDefaultSpeed);
+    m_tunableServoAngle = new DashboardTunable("ANGLE TO SET", 0);
     frc::SmartDashboard::PutString("AutoStep::RunPrerecorded::Values", "");
     frc::SmartDashboard::PutString("Recorder::output_file_string", "");
     frc::SmartDashboard::PutNumber("LimelightLock end", .25);
-    frc::SmartDashboard::PutNumber("ANGLE TO SET", 0);
+    telemetry.start(Recorder::GetDirectory());
+    climber.start();
+    swerveUnlock.start();
+    sensors.start();
+    driveController.start();
+    galacticSearch.preload();
+}
+void Robot::RobotPeriodic() {
+
+    //Scoped so that the phase ends before the loop does.
+    {
+        LoopProfiler::Scope scope(profiler, LoopProfiler::kTelemetry);
+
+        canTelemetry.update();
+
+        telemetryBattery.log(frc::RobotController::GetInputVoltage());
+        telemetryDropped.log(telemetry.getDropped());
+        const SensorFrame &frame = sensors.getFrame();
+        telemetryYaw.log(frame.yaw);
+        telemetryYawRate.log(frame.yawRate);
+        telemetryTargetCaptureYaw.log(frame.targetCaptureYaw);
+        telemetryDrivePosition.log(frame.drivePositions[SwerveKinematics::kFrontRight]);
+        VectorDouble velocity = chassisVelocity.getVelocity();
+        telemetryVelocityI.log(velocity.i);
+        telemetryVelocityJ.log(velocity.j);
+        telemetryLaunchRPM.log(launcher.getLaunchRPM());
+        telemetryIndexCurrent.log(launcher.getIndexCurrent());
+        telemetryTargetVisible.log(frame.targetVisible);
+        telemetryTargetX.log(frame.targetHorizontalOffset);
+        telemetryTargetY.log(frame.targetVerticalOffset);
+        telemetryTargetArea.log(frame.targetArea);
+        telemetryGalacticSearchPath.log(galacticSearch.getPath());
+        telemetryGalacticSearchLatency.log(galacticSearch.getLatency());
+        telemetryBallCount.log(frame.ballCount);
+        dashboardBallCount.set(frame.ballCount);
+        telemetryClimberAtBottom.log(frame.climberAtBottom);
+        telemetryClimberBottomCuts.log(climber.getBottomCuts());
+
+        driveController.update();
+        dashboard.update();
+    }
+    profiler.endLoop();
 }
-void Robot::RobotPeriodic() {}
 void Robot::AutonomousInit() {
 
+    //Auto steps drive Zion themselves.
+    DriveController::Direct direct(driveController);
+    sensors.update();
     masterAuto.Reset();
+    m_autoComplete = false;
+    ballCounter.setCount(R_ballCounterPreloaded);
+    //Nothing updates the velocity estimate in auto, so the lock-on steps'
+    //compensator only corrects tx for turning since its capture.
+    chassisVelocity.reset();
+    profiler.reset();
     //Set the zero position before beginning auto, as it should have been
     //calibrated before the match. This persists for the match duration unless
     //overriden.
     zion.SetZeroPosition();
     navX.resetYaw();
     //Get which auto was selected to run in auto to test against.
-    m_chooserAutoSelected = m_chooserAuto->GetSelected();
+    m_selectionAuto->refresh();
+    m_chooserAutoSelected = m_selectionAuto->getSelected();
     
     //If-We-Gotta-Do-It simply drives off the line.
     if (m_chooserAutoSelected == "dotl") {
 
         masterAuto.AddStep(new AssumeDirectionAbsolute(zion, SwerveTrain::ZionDirections::kLeft));
-        masterAuto.AddStep(new AssumeDistance(zion, 30, SwerveTrain::ZionDirections::kLeft));
+        masterAuto.AddStep(new AssumeDistance(zion, sensors, 30, SwerveTrain::ZionDirections::kLeft));
     }
     else if (m_chooserAutoSelected == "Path A Recorded") {
 
-        masterAuto.AddStep(new RunPrerecorded(zion, limelight, "path-a"));
+        masterAuto.AddStep(new RunPrerecorded(zion, limelight, "path-a", &shotCompensator));
     }
     else if (m_chooserAutoSelected == "Path A Recorded and shoot") {
 
-        masterAuto.AddStep(new RunPrerecorded(zion, limelight, "path-a"));
-        
-        AsyncLoop* spoolUp = new AsyncLoop;
-        spoolUp->AddStep(new SetLauncherRPM(launcher, R_launcherDefaultSpeed, true));
-        spoolUp->AddStep(new AimLauncher(launcher, limelight));
-        spoolUp->AddStep(new LimelightLock(zion, limelight));
-        spoolUp->AddStep(new WaitSeconds(5));
-        masterAuto.AddStep(spoolUp);
+        //Spin up and aim while driving the path. Where the recording was
+        //locked on to the target, playback locks on too, so Zion arrives
+        //already aimed and spun up.
+        AsyncLoop* path = new AsyncLoop;
+        path->AddStep(new RunPrerecorded(zion, limelight, "path-a", &shotCompensator));
+        path->AddStep(new SetLauncherRPM(launcher, R_launcherDefaultSpeed, false));
+        path->AddStep(new AimLauncher(launcher, limelight, &shotCompensator));
+        masterAuto.AddStep(path);
+
+        //Finish locking on, in case the path ended off target.
+        AsyncLoop* lock = new AsyncLoop;
+        lock->AddStep(new LimelightLock(zion, limelight, &shotCompensator));
+        lock->AddStep(new AimLauncher(launcher, limelight, &shotCompensator));
+        masterAuto.AddStep(lock);
 
-        AutoSequence* indexLoop = new AutoSequence(true);
-        indexLoop->AddStep(new SetIndexSpeed(launcher, R_launcherDefaultSpeedIndex));
-        indexLoop->AddStep(new WaitSeconds(0.25));
-        indexLoop->AddStep(new SetIndexSpeed(launcher, 0.0));
-        indexLoop->AddStep(new WaitSeconds(1));
-        
         AsyncLoop* loop = new AsyncLoop;
-        loop->AddStep(indexLoop);
-        loop->AddStep(new LimelightLock(zion, limelight));
-        loop->AddStep(new AimLauncher(launcher, limelight));
+        loop->AddStep(new ShootSequence(launcher, ballCounter, R_launcherDefaultSpeedIndex));
+        loop->AddStep(new LimelightLock(zion, limelight, &shotCompensator));
+        loop->AddStep(new AimLauncher(launcher, limelight, &shotCompensator));
         masterAuto.AddStep(loop);
     }
     else if (m_chooserAutoSelected == "Path A Non-Pre-recorded") {
     
         masterAuto.AddStep(new AssumeDirectionAbsolute(zion, SwerveTrain::ZionDirections::kRight));
-        masterAuto.AddStep(new AssumeDistance(zion, 134, SwerveTrain::ZionDirections::kRight));
+        masterAuto.AddStep(new AssumeDistance(zion, sensors, 134, SwerveTrain::ZionDirections::kRight));
         masterAuto.AddStep(new AssumeDirectionAbsolute(zion, SwerveTrain::ZionDirections::kBackward));
-        masterAuto.AddStep(new AssumeDistance(zion, 53, SwerveTrain::ZionDirections::kBackward));
+        masterAuto.AddStep(new AssumeDistance(zion, sensors, 53, SwerveTrain::ZionDirections::kBackward));
         masterAuto.AddStep(new AssumeDirectionAbsolute(zion, SwerveTrain::ZionDirections::kLeft));
-        masterAuto.AddStep(new AssumeDistance(zion, 53, SwerveTrain::ZionDirections::kLeft));
+        masterAuto.AddStep(new AssumeDistance(zion, sensors, 53, SwerveTrain::ZionDirections::kLeft));
         masterAuto.AddStep(new AssumeDirectionAbsolute(zion, SwerveTrain::ZionDirections::kForward));
-        masterAuto.AddStep(new AssumeDistance(zion, 53, SwerveTrain::ZionDirections::kForward));
-        masterAuto.AddStep(new AssumeDirectionAbsolute(zion, new VectorDouble(143, 7)));
-        masterAuto.AddStep(new AssumeDistance(zion, 143, new VectorDouble(143, 7)));
+        masterAuto.AddStep(new AssumeDistance(zion, sensors, 53, SwerveTrain::ZionDirections::kForward));
+        masterAuto.AddStep(new AssumeDirectionAbsolute(zion, VectorDouble(143, 7)));
+        masterAuto.AddStep(new AssumeDistance(zion, sensors, 143, VectorDouble(143, 7)));
         masterAuto.AddStep(new AssumeDirectionAbsolute(zion, SwerveTrain::ZionDirections::kForward));
-        masterAuto.AddStep(new AssumeDistance(zion, 53, SwerveTrain::ZionDirections::kForward));
+        masterAuto.AddStep(new AssumeDistance(zion, sensors, 53, SwerveTrain::ZionDirections::kForward));
         masterAuto.AddStep(new AssumeDirectionAbsolute(zion, SwerveTrain::ZionDirections::kLeft));
-        masterAuto.AddStep(new AssumeDistance(zion, 53, SwerveTrain::ZionDirections::kLeft));
+        masterAuto.AddStep(new AssumeDistance(zion, sensors, 53, SwerveTrain::ZionDirections::kLeft));
         masterAuto.AddStep(new AssumeDirectionAbsolute(zion, SwerveTrain::ZionDirections::kBackward));
-        masterAuto.AddStep(new AssumeDistance(zion, 53, SwerveTrain::ZionDirections::kBackward));
-        masterAuto.AddStep(new AssumeDirectionAbsolute(zion, new VectorDouble(60, -60)));
-        masterAuto.AddStep(new AssumeDistance(zion, 84.85281374, new VectorDouble(60, -60)));
+        masterAuto.AddStep(new AssumeDistance(zion, sensors, 53, SwerveTrain::ZionDirections::kBackward));
+        masterAuto.AddStep(new AssumeDirectionAbsolute(zion, VectorDouble(60, -60)));
+        masterAuto.AddStep(new AssumeDistance(zion, sensors, 84.85281374, VectorDouble(60, -60)));
         masterAuto.AddStep(new AssumeDirectionAbsolute(zion, SwerveTrain::ZionDirections::kRight));
-        masterAuto.AddStep(new AssumeDistance(zion, 53, SwerveTrain::ZionDirections::kRight));
+        masterAuto.AddStep(new AssumeDistance(zion, sensors, 53, SwerveTrain::ZionDirections::kRight));
         masterAuto.AddStep(new AssumeDirectionAbsolute(zion, SwerveTrain::ZionDirections::kForward));
-        masterAuto.AddStep(new AssumeDistance(zion, 53, SwerveTrain::ZionDirections::kForward));
+        masterAuto.AddStep(new AssumeDistance(zion, sensors, 53, SwerveTrain::ZionDirections::kForward));
         masterAuto.AddStep(new AssumeDirectionAbsolute(zion, SwerveTrain::ZionDirections::kLeft));
-        masterAuto.AddStep(new AssumeDistance(zion, 284, SwerveTrain::ZionDirections::kLeft));
+        masterAuto.AddStep(new AssumeDistance(zion, sensors, 284, SwerveTrain::ZionDirections::kLeft));
     }
     else if (m_chooserAutoSelected == "Path B Recorded") {
 
-        masterAuto.AddStep(new RunPrerecorded(zion, limelight, "path-b"));
+        masterAuto.AddStep(new RunPrerecorded(zion, limelight, "path-b", &shotCompensator));
+    }
+    else if (m_chooserAutoSelected == "Galactic Search") {
+
+        masterAuto.AddStep(new RunGalacticSearch(zion, limelight, galacticSearch));
     }
     else if (m_chooserAutoSelected == "brp") {
 
-        masterAuto.AddStep(new RunPrerecorded(zion, limelight, "brp"));
+        masterAuto.AddStep(new RunPrerecorded(zion, limelight, "brp", &shotCompensator));
     }
     else if (m_chooserAutoSelected == "sp") {
 
-        masterAuto.AddStep(new RunPrerecorded(zion, limelight, "sp"));
+        masterAuto.AddStep(new RunPrerecorded(zion, limelight, "sp", &shotCompensator));
     }
     else if (m_chooserAutoSelected == "bp") {
 
-        masterAuto.AddStep(new RunPrerecorded(zion, limelight, "bp"));
+        masterAuto.AddStep(new RunPrerecorded(zion, limelight, "bp", &shotCompensator));
     }
     else if (m_chooserAutoSelected == "Launch Power Cells") {
 
         AsyncLoop* spoolUp = new AsyncLoop;
         spoolUp->AddStep(new SetLauncherRPM(launcher, R_launcherDefaultSpeed, true));
-        spoolUp->AddStep(new AimLauncher(launcher, limelight));
-        spoolUp->AddStep(new LimelightLock(zion, limelight));
+        spoolUp->AddStep(new AimLauncher(launcher, limelight, &shotCompensator));
+        spoolUp->AddStep(new LimelightLock(zion, limelight, &shotCompensator));
         spoolUp->AddStep(new WaitSeconds(5));
         masterAuto.AddStep(spoolUp);
 
-        AutoSequence* indexLoop = new AutoSequence(true);
-        indexLoop->AddStep(new SetIndexSpeed(launcher, R_launcherDefaultSpeedIndex));
-        indexLoop->AddStep(new WaitSeconds(0.25));
-        indexLoop->AddStep(new SetIndexSpeed(launcher, 0.0));
-        indexLoop->AddStep(new WaitSeconds(1));
-        
         AsyncLoop* loop = new AsyncLoop;
-        loop->AddStep(indexLoop);
-        loop->AddStep(new LimelightLock(zion, limelight));
-        loop->AddStep(new AimLauncher(launcher, limelight));
+        loop->AddStep(new ShootSequence(launcher, ballCounter, R_launcherDefaultSpeedIndex));
+        loop->AddStep(new LimelightLock(zion, limelight, &shotCompensator));
+        loop->AddStep(new AimLauncher(launcher, limelight, &shotCompensator));
         masterAuto.AddStep(loop);
     }
     else if (m_chooserAutoSelected == "test pre-recorded") {
 
-        masterAuto.AddStep(new RunPrerecorded(zion, limelight, "test"));
+        masterAuto.AddStep(new RunPrerecorded(zion, limelight, "test", &shotCompensator));
     }
 
     masterAuto.Init();
 }
 void Robot::AutonomousPeriodic() {
 
+    LoopProfiler::Scope scope(profiler, LoopProfiler::kAuto);
+    DriveController::Direct direct(driveController);
+    sensors.update();
     //Lock the drive and swerve wheels before beginning for accuracy.
     zion.SetSwerveBrake(true);
     zion.SetDriveBrake(true);
     //Run the auto!
     if (masterAuto.Execute()) {
 
+        m_autoComplete = true;
         zion.AssumeZeroPosition();
     }
 }
 void Robot::TeleopInit() {
 
+    DriveController::Direct direct(driveController);
     //To clean up adter auto, confirm the swerves and drives are locked
     zion.SetSwerveBrake(true);
     zion.SetDriveBrake(true);
     navX.resetYaw();
+    chassisVelocity.reset();
+    profiler.reset();
+    //A climb interrupted by disabling is not picked up again.
+    climbSequence.cancel();
 }
 void Robot::TeleopPeriodic() {
-    
-    zion.PrintDrivePositions();
+
+    //Each phase is timed until the next begins; see LoopProfiler.h.
+    LoopProfiler::Scope scope(profiler, LoopProfiler::kInput);
+    sensors.update();
+    const SensorFrame &frame = sensors.getFrame();
+    //Only stored here; the dashboard writes them every
+    //R_dashboardDebugPeriod.
+    for (int module = 0; module < 4; ++module) {
+
+        dashboardDrivePositions[module].set(frame.drivePositions[module]);
+    }
+
+    //Read every control once, up front; the rest of the loop works from
+    //this snapshot.
+    DriverInputs in = DriverInputs::sample(*playerOne, *playerTwo, *playerThree);
+    if (m_selectionController->refresh()) {
+
+        m_useXboxController = m_selectionController->getSelected() == "XboxController";
+    }
 
     double x;
     double y;
     double z;
-    if (m_chooserController->GetSelected() == "XboxController") {
+    if (m_useXboxController) {
         
-        x = playerOne->GetX(frc::GenericHID::kLeftHand);
-        y = playerOne->GetY(frc::GenericHID::kLeftHand);
-        z = playerOne->GetX(frc::GenericHID::kRightHand);
+        x = in.playerOne.leftX;
+        y = in.playerOne.leftY;
+        z = in.playerOne.rightX;
     }
     else {
 
-        x = playerThree->GetX();
-        y = playerThree->GetY();
-        z = playerThree->GetZ();
+        x = in.playerThree.x;
+        y = in.playerThree.y;
+        z = in.playerThree.z;
     }
     Controller::forceControllerXYZToZeroInDeadzone(x, y, z);
     z *= R_executionCapZionZ;
+    telemetryDriveX.log(x);
+    telemetryDriveY.log(y);
+    telemetryDriveZ.log(z);
+    //Zion is driven by the inverse of the sticks.
+    chassisVelocity.update(-x, -y);
+
+    //While locked on to the target, lead it by Zion's velocity so that it can
+    //be scored on the move. At a standstill this is the plain Limelight lock.
+    bool limelightLockEngaged = m_useXboxController ? in.playerOne.leftBumper : in.playerThree.button6;
+    scope.next(LoopProfiler::kVision);
+    ShotCompensator::Solution shot = shotCompensator.solve();
 
-    if (m_chooserController->GetSelected() == "XboxController") {
+    scope.next(LoopProfiler::kDrive);
+    if (m_useXboxController) {
 
-        if (playerOne->GetYButton()) {
+        if (in.playerOne.buttonY) {
 
+            DriveController::Direct direct(driveController);
             zion.SetZeroPosition();
         }
-        if (playerOne->GetBButton()) {
+        if (in.playerOne.buttonB) {
 
             navX.resetYaw();
         }
-        if (playerOne->GetAButton()) {
+        if (in.playerOne.buttonA) {
 
+            DriveController::Direct direct(driveController);
             zion.AssumeZeroPosition();
         }
         else {
 
-            zion.Drive(
+            driveController.drive(
                 -x,
                 -y,
-                playerOne->GetBumper(frc::GenericHID::kLeftHand) ? limelight.CalculateLimelightLockSpeed() : z,
-                playerOne->GetBumper(frc::GenericHID::kLeftHand),
+                limelightLockEngaged ? limelight.CalculateLimelightLockSpeed(shot.offset) : z,
+                in.playerOne.leftBumper,
                 false,
                 false
             );
         }
-        if (playerOne->GetXButton()) {
+        if (in.playerOne.buttonX) {
 
-            recorder.Record(x, y, z, false);
+            recorder.Record(x, y, z, false, limelightLockEngaged);
         }
         else {
            
@@ -284,33 +451,35 @@ void Robot::TeleopPeriodic() {
     }
     else {
 
-        if (playerThree->GetRawButton(3)) {
+        if (in.playerThree.button3) {
 
+            DriveController::Direct direct(driveController);
             zion.SetZeroPosition();
         }
-        if (playerThree->GetRawButton(4)) {
+        if (in.playerThree.button4) {
 
             navX.resetYaw();
         }
-        if (playerThree->GetRawButton(12)) {
+        if (in.playerThree.button12) {
 
+            DriveController::Direct direct(driveController);
             zion.AssumeZeroPosition();
         }
         else {
 
-            zion.Drive(
+            driveController.drive(
                 -x,
                 -y,
-                playerThree->GetRawButton(6) ? limelight.CalculateLimelightLockSpeed() : z,
-                playerThree->GetRawButton(5),
-                playerThree->GetRawButton(7),
-                playerThree->GetRawButton(2),
-                -(((playerThree->GetThrottle() + 1.0) / 2.0) - 1.0)
+                limelightLockEngaged ? limelight.CalculateLimelightLockSpeed(shot.offset) : z,
+                in.playerThree.button5,
+                in.playerThree.button7,
+                in.playerThree.button2,
+                -(((in.playerThree.throttle + 1.0) / 2.0) - 1.0)
             );
         }
-        /*if (playerThree->GetRawButton(1)) {
+        /*if (in.playerThree.button1) {
 
-            recorder.Record(x, y, z, false);
+            recorder.Record(x, y, z, false, limelightLockEngaged);
         }
         else {
 
@@ -318,6 +487,8 @@ void Robot::TeleopPeriodic() {
         }*/
     }
 
+    scope.next(LoopProfiler::kMechanism);
+
     //The second controller works in control layers on top of the basic
     //driving mode engaged with function buttons. If one of the functions
     //running under a button loses its button press, it will be overriden
@@ -326,15 +497,15 @@ void Robot::TeleopPeriodic() {
     //The back button is "manual override" control layer. No auto, simply
     //writes unupdated values directly to motors, unlocking the climber,
     //with no execution caps or impediments. Overrides all other layers.
-    if (playerTwo->GetBackButton()) {
+    if (in.playerTwo.buttonBack) {
 
         m_booleanClimberLock =      false;
-        m_speedClimberClimb =       -playerTwo->GetTriggerAxis(frc::GenericHID::kLeftHand) + playerTwo->GetTriggerAxis(frc::GenericHID::kRightHand);
-        m_speedClimberTranslate =    playerTwo->GetX(frc::GenericHID::kLeftHand);
-        m_speedClimberWheel =        playerTwo->GetX(frc::GenericHID::kRightHand);
-        m_speedIntake =             -playerTwo->GetTriggerAxis(frc::GenericHID::kLeftHand) + playerTwo->GetTriggerAxis(frc::GenericHID::kRightHand);
-        m_speedLauncherIndex =      -playerTwo->GetY(frc::GenericHID::kLeftHand);
-        m_speedLauncherLaunch =     -playerTwo->GetY(frc::GenericHID::kRightHand);
+        m_speedClimberClimb =       -in.playerTwo.leftTrigger + in.playerTwo.rightTrigger;
+        m_speedClimberTranslate =    in.playerTwo.leftX;
+        m_speedClimberWheel =        in.playerTwo.rightX;
+        m_speedIntake =             -in.playerTwo.leftTrigger + in.playerTwo.rightTrigger;
+        m_speedLauncherIndex =      -in.playerTwo.leftY;
+        m_speedLauncherLaunch =     -in.playerTwo.rightY;
     }
     else {
 
@@ -348,16 +519,24 @@ void Robot::TeleopPeriodic() {
     }
 
     //The start button is "climber" control layer. Controls nothing but the
-    //climber. Overrides the auto layer.
-    if (!playerTwo->GetBackButton() && playerTwo->GetStartButton()) {
+    //climber. Overrides the auto layer. A within it starts the automated
+    //climb, which drives the climber for as long as the layer is held, and
+    //is cancelled when it is released.
+    if (!in.playerTwo.buttonBack && in.playerTwo.buttonStart) {
 
-        m_speedClimberClimb =       -playerTwo->GetTriggerAxis(frc::GenericHID::kLeftHand) + playerTwo->GetTriggerAxis(frc::GenericHID::kRightHand);
-        m_speedClimberTranslate =    playerTwo->GetX(frc::GenericHID::kLeftHand);
-        m_speedClimberWheel =        playerTwo->GetX(frc::GenericHID::kRightHand);
-        m_booleanClimberLock =      !playerTwo->GetBumper(frc::GenericHID::kRightHand);
+        if (in.playerTwo.buttonAPressed) {
+
+            climbSequence.start();
+        }
+        climbSequence.update();
+        m_speedClimberClimb =       -in.playerTwo.leftTrigger + in.playerTwo.rightTrigger;
+        m_speedClimberTranslate =    in.playerTwo.leftX;
+        m_speedClimberWheel =        in.playerTwo.rightX;
+        m_booleanClimberLock =      !in.playerTwo.rightBumper;
     }
     else {
 
+        climbSequence.cancel();
         m_speedClimberClimb =       0;
         m_speedClimberTranslate =   0;
         m_speedClimberWheel =       0;
@@ -365,60 +544,95 @@ void Robot::TeleopPeriodic() {
     }
 
     //If no layers were engaged, regular driving can begin.
-    if (!playerTwo->GetBackButton() && !playerTwo->GetStartButton() && !playerTwo->GetRawButton(9)) {
+    if (!in.playerTwo.buttonBack && !in.playerTwo.buttonStart && !in.playerTwo.button9) {
+
+        m_speedIntake = (-in.playerTwo.leftTrigger + in.playerTwo.rightTrigger) * R_executionCapIntake;
+        //Stop taking in once the magazine is full. Spitting out still works,
+        //and the manual override layer ignores the count.
+        if (m_speedIntake > 0 && frame.ballCount >= R_launcherMagazineCapacity) {
 
-        m_speedIntake = (-playerTwo->GetTriggerAxis(frc::GenericHID::kLeftHand) + playerTwo->GetTriggerAxis(frc::GenericHID::kRightHand)) * R_executionCapIntake;
+            m_speedIntake = 0;
+        }
 
-        if (playerTwo->GetAButton()) {
+        if (in.playerTwo.buttonA) {
 
-            m_speedLauncherIndex = frc::SmartDashboard::GetNumber("Field::Launcher::Speed-Index:", R_launcherDefaultSpeedIndex);
+            m_speedLauncherIndex = m_tunableSpeedIndex->get();
         }
         else {
 
             m_speedLauncherIndex = 0;
         }
-        if (playerTwo->GetXButton()) {
+        if (in.playerTwo.buttonX) {
 
-            m_speedLauncherLaunch =frc::SmartDashboard::GetNumber("Field::Launcher::Speed-Launcher", R_launcherDefaultSpeed);
+            m_speedLauncherLaunch = m_tunableSpeedLauncher->get();
         }
-        if (!playerTwo->GetXButton()) {
+        if (!in.playerTwo.buttonX) {
 
             m_speedLauncherLaunch = 0;
         }
-        if (playerTwo->GetBumperPressed(frc::GenericHID::kLeftHand)) {
+        if (in.playerTwo.leftBumperPressed) {
 
             m_servoPosition = m_servoPosition - 90;
         }
-        else if (playerTwo->GetBumperPressed(frc::GenericHID::kRightHand)) {
+        else if (in.playerTwo.rightBumperPressed) {
            
             m_servoPosition = m_servoPosition + 90;
         }
     }
 
-    // Sets the servos to a position based on a quintic regression model with
-    // respect to the area detected by the limelight
-    /*double area = limelight.getTargetArea();
-    m_servoPosition = -812.644 * pow(area, 6) + 7108.25 * pow(area, 5) - 24539.6 * pow(area, 4) + 41879.3 * pow(area, 3) - 35627.7 * pow(area, 2) + 12700.6 * area -679.787;
-    m_servoPosition = (m_servoPosition < 0 || m_servoPosition > 180) ? (m_servoPosition < 0 ? 0 : 180) : m_servoPosition;
-    if (area < 1.0) {
+    //The hood is aimed from the dashboard for tuning, unless P1 is locked on
+    //to the target, in which case it and the launch speed follow the lead.
+    m_servoPosition = m_tunableServoAngle->get();
+    if (limelightLockEngaged && frame.targetVisible) {
+
+        m_servoPosition = shot.launcher.servo;
+        m_speedLauncherLaunch *= shot.launchScale;
+    }
+
+    //While calibrating the launcher, P2 marks each shot as it lands with the
+    //D-pad: up for a score, down for a miss. The shot is recorded with what
+    //the launcher and Limelight are doing at that moment, and the launch
+    //speed it was fired with, even if the flywheel has since been released.
+    if (m_speedLauncherLaunch != 0) {
+
+        m_calibrationLaunchSpeed = m_speedLauncherLaunch;
+    }
+    if (in.playerTwo.pov == 0 || in.playerTwo.pov == 180) {
+
+        if (!m_calibrationShotWasMarked) {
+
+            m_calibrationShotWasMarked = true;
+            calibrationLogger.record(
+                frame.targetArea,
+                launcher.getLaunchRPM(),
+                m_servoPosition,
+                m_calibrationLaunchSpeed,
+                frame.targetVerticalOffset,
+                in.playerTwo.pov == 0
+            );
+        }
+    }
+    else {
 
-        m_servoPosition = 19;
-    }*/
-    m_servoPosition = frc::SmartDashboard::GetNumber("ANGLE TO SET", 0);
+        m_calibrationShotWasMarked = false;
+    }
 
     //Once all layers have been evaluated, write out all of their values.
     //Doing this only once prevents weird bugs in which multiple different
     //values get set at different times in the loop.
-    climber.lock(m_booleanClimberLock);
-    climber.setSpeed(Climber::Motor::kClimb, m_speedClimberClimb);
-    climber.setSpeed(Climber::Motor::kTranslate, m_speedClimberTranslate);
-    climber.setSpeed(Climber::Motor::kWheel, m_speedClimberWheel);
+    if (!climbSequence.isRunning()) {
+
+        climber.lock(m_booleanClimberLock);
+        climber.setSpeed(Climber::Motor::kClimb, m_speedClimberClimb);
+        climber.setSpeed(Climber::Motor::kTranslate, m_speedClimberTranslate);
+        climber.setSpeed(Climber::Motor::kWheel, m_speedClimberWheel);
+    }
     intake.setSpeed(m_speedIntake);
     launcher.setIndexSpeed(m_speedLauncherIndex);
     launcher.setLaunchSpeed(m_speedLauncherLaunch);
     launcher.setServo(Launcher::kSetAngle, m_servoPosition);
 
-    if (playerTwo->GetYButton()) {
+    if (in.playerTwo.buttonY) {
 
         launcher.setBrake(true);
     }
@@ -426,32 +640,64 @@ void Robot::TeleopPeriodic() {
 
         launcher.setBrake(false);
     }
-
-    zion.Stop();
 }
 void Robot::DisabledPeriodic() {
 
+    LoopProfiler::Scope scope(profiler, LoopProfiler::kInput);
+    sensors.update();
     //Whenever Zion is disabled, check if the lock switch has been pressed. If
     //so, toggle the current swerve module lock state. This is useful when
     //zeroing the wheels (yay zero team).
-    if (switchSwerveUnlock.Get()) {
-
-        if (!m_zeroButtonWasPressed) {
+    //Presses are counted by interrupt, so even one between loops toggles.
+    if (sensors.getFrame().swerveUnlockPresses != m_swerveUnlockPresses) {
 
-            m_zeroButtonWasPressed = true;
-            m_swerveBrake = !m_swerveBrake;
-            zion.SetSwerveBrake(m_swerveBrake);
-        }
+        m_swerveUnlockPresses = sensors.getFrame().swerveUnlockPresses;
+        m_swerveBrake = !m_swerveBrake;
+        DriveController::Direct direct(driveController);
+        zion.SetSwerveBrake(m_swerveBrake);
     }
-    else {
-
-        m_zeroButtonWasPressed = false;
+    scope.next(LoopProfiler::kVision);
+    //While Galactic Search is selected, watch for its layout, so that auto
+    //can drive it the moment it begins. Power Cells are seen without the
+    //LEDs.
+    m_selectionAuto->refresh();
+    if (m_selectionAuto->getSelected() == "Galactic Search") {
+
+        galacticSearch.start();
+        galacticSearch.update();
+        limelight.setLime(false);
+        limelight.setProcessing(true);
+        return;
     }
+    galacticSearch.stop();
     //Whenever Zion is on, allow control of the Limelight from P2. This permits
     //using it for manual alignment at any time, before or after the match.
     //Also turn on if the swerve modules are in coast.
-    limelight.setLime(!m_swerveBrake || playerTwo->GetBumper(frc::GenericHID::kLeftHand));
-    limelight.setProcessing(playerTwo->GetBumper(frc::GenericHID::kLeftHand));
+    bool limelightRequested = playerTwo->GetBumper(frc::GenericHID::kLeftHand);
+    limelight.setLime(!m_swerveBrake || limelightRequested);
+    limelight.setProcessing(limelightRequested);
+}
+void Robot::SimulationInit() {
+
+    simulation.init();
+    //With ZION_SIM_AUTO set to an auto's chooser value, run it headless and
+    //exit rather than waiting for a driver station. ZION_SIM_RECORDING names
+    //the recording to measure its path against.
+    const char *routine = std::getenv("ZION_SIM_AUTO");
+    if (routine != nullptr) {
+
+        const char *recording = std::getenv("ZION_SIM_RECORDING");
+        m_chooserAuto->SetDefaultOption(routine, routine);
+        std::exit(simulation.runHeadlessAuto(*this, recording != nullptr ? recording : ""));
+    }
+}
+void Robot::SimulationPeriodic() {
+
+    simulation.update(R_simLoopPeriod);
+}
+bool Robot::isAutoComplete() {
+
+    return m_autoComplete;
 }
 
 #ifndef RUNNING_FRC_TESTS
@@ -0,0 +1,186 @@
+/*
+class BallCounter
+
+Constructors
+
+    BallCounter(Intake&, Launcher&)
+        Creates a count of the Power Cells on board, kept from the current
+        drawn by the supplied intake and launcher's index. Begins at
+        R_ballCounterPreloaded.
+
+Public Methods
+
+    void sample(const double&)
+        Reads both motors' currents at the supplied FPGA time in seconds and
+        counts any Power Cell taken in or fed. Called by SensorSampler on
+        every sample, so only from its thread.
+    int getCount()
+        Returns how many Power Cells are on board, from 0 to
+        R_launcherMagazineCapacity.
+    bool isFull()
+        Returns true if the magazine holds R_launcherMagazineCapacity.
+    void setCount(const int&)
+        Corrects the count, such as to the preload before auto, or to 0 once
+        the magazine is seen to be empty.
+    uint32_t getIngested()
+    uint32_t getFed()
+        Return how many Power Cells the intake has taken in and the index
+        has fed to the flywheel since construction.
+
+Each Power Cell squeezed past a roller loads its motor, so its current
+rises above what the motor draws running empty. That empty current is
+followed as a baseline while nothing is passing, and a Power Cell is counted
+once the current has stayed R_ballCounter...SpikeCurrent above it for
+R_ballCounterSpikeTime. The spike must fall back within half of that before
+another is counted. The intake counts up while taking in (and down while
+spitting out); the index counts down while feeding. Spikes are ignored for
+R_ballCounterStartupTime after a motor starts or reverses, as starting draws
+a surge of its own.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "Intake.h"
+#include "Launcher.h"
+#include "RobotMap.h"
+
+class BallCounter {
+
+    public:
+        BallCounter(Intake &refIntake, Launcher &refLauncher) {
+
+            m_intake = &refIntake;
+            m_launcher = &refLauncher;
+            m_count = R_ballCounterPreloaded;
+            m_ingested = 0;
+            m_fed = 0;
+            m_intakeSpike = Spike();
+            m_indexSpike = Spike();
+        }
+
+        void sample(const double &time) {
+
+            int intakeDirection = detect(m_intakeSpike, time, m_intake->getSpeed(), m_intake->getCurrent(), R_ballCounterIntakeSpikeCurrent);
+            if (intakeDirection > 0) {
+
+                add(1);
+                m_ingested++;
+            }
+            else if (intakeDirection < 0) {
+
+                add(-1);
+            }
+            //Only feeding towards the flywheel empties the magazine.
+            if (detect(m_indexSpike, time, m_launcher->getIndexSpeed(), m_launcher->getIndexCurrent(), R_ballCounterIndexSpikeCurrent) > 0) {
+
+                add(-1);
+                m_fed++;
+            }
+        }
+
+        int getCount() {
+
+            return m_count.load();
+        }
+        bool isFull() {
+
+            return getCount() >= R_launcherMagazineCapacity;
+        }
+        void setCount(const int &count) {
+
+            m_count = clamp(count);
+        }
+
+        uint32_t getIngested() {
+
+            return m_ingested.load();
+        }
+        uint32_t getFed() {
+
+            return m_fed.load();
+        }
+
+    private:
+        struct Spike {
+
+            //The direction the motor ran last sample, and since when.
+            int direction;
+            double directionTime;
+            double baseline;
+            //When the current last rose above the baseline, and whether
+            //this spike has been counted.
+            bool spiking;
+            double spikeTime;
+            bool counted;
+        };
+
+        //Returns the direction the motor was running if a Power Cell has
+        //just passed it, or 0.
+        static int detect(Spike &spike, const double &time, const double &speed, const double &current, const double &spikeCurrent) {
+
+            int direction = speed > 0 ? 1 : (speed < 0 ? -1 : 0);
+            if (direction != spike.direction) {
+
+                spike.direction = direction;
+                spike.directionTime = time;
+                spike.spiking = false;
+            }
+            if (direction == 0 || time - spike.directionTime < R_ballCounterStartupTime) {
+
+                spike.baseline = current;
+                return 0;
+            }
+            double above = current - spike.baseline;
+            if (!spike.spiking) {
+
+                if (above >= spikeCurrent) {
+
+                    spike.spiking = true;
+                    spike.spikeTime = time;
+                    spike.counted = false;
+                }
+                else {
+
+                    spike.baseline += (current - spike.baseline) * R_ballCounterBaselineRate;
+                    return 0;
+                }
+            }
+            if (above < spikeCurrent / 2) {
+
+                spike.spiking = false;
+                return 0;
+            }
+            if (!spike.counted && time - spike.spikeTime >= R_ballCounterSpikeTime) {
+
+                spike.counted = true;
+                return direction;
+            }
+            return 0;
+        }
+
+        static int clamp(const int &count) {
+
+            return count < 0 ? 0 : (count > R_launcherMagazineCapacity ? R_launcherMagazineCapacity : count);
+        }
+
+        void add(const int &change) {
+
+            int count = m_count.load();
+            while (!m_count.compare_exchange_weak(count, clamp(count + change)));
+        }
+
+        Intake *m_intake;
+        Launcher *m_launcher;
+
+        //Only the sampler's thread reads the motors.
+        Spike m_intakeSpike;
+        Spike m_indexSpike;
+
+        std::atomic<int> m_count;
+        std::atomic<uint32_t> m_ingested;
+        std::atomic<uint32_t> m_fed;
+};
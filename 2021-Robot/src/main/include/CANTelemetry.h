@@ -0,0 +1,164 @@
+/*
+class CANTelemetry
+
+Constructors
+
+    CANTelemetry(DashboardPublisher&)
+        Creates a monitor for the CAN bus and the outputs which write to it,
+        which publishes through the supplied publisher.
+
+Public Methods
+
+    void update()
+        Call once per loop (from RobotPeriodic). Samples the bus status and
+        the loop time every loop, which costs no CAN traffic, and publishes
+        a summary to the SmartDashboard every R_canTelemetryPublishPeriod
+        (only the values which changed are written):
+
+        CAN::Utilization         Bus utilization, 0-1.
+        CAN::TxErrors/RxErrors   Transmit and receive error counts.
+        CAN::BusOff/TxFull       Bus-off and full transmit buffer counts.
+        CAN::LoopSpikes          Loops longer than R_canTelemetryLoopSpikeTime.
+        CAN::LoopSpikesWithErrors  Those of them during which the CAN error
+                                 counts rose.
+        CAN::LastSpike           The length of the last spike, and the error
+                                 counts which rose during it.
+        CAN::FramesPerSecond     Frames per second sent by each cached output
+                                 on the bus, and the total suppressed.
+
+Only outputs made through CachedOutput are counted per device.
+*/
+
+#pragma once
+
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include <frc/RobotController.h>
+#include <frc/Timer.h>
+
+#include "CachedOutput.h"
+#include "DashboardPublisher.h"
+#include "RobotMap.h"
+
+class CANTelemetry {
+
+    public:
+        CANTelemetry(DashboardPublisher &publisher) :
+            m_utilization(publisher, "CAN::Utilization", R_canTelemetryPublishPeriod),
+            m_txErrors(publisher, "CAN::TxErrors", R_canTelemetryPublishPeriod),
+            m_rxErrors(publisher, "CAN::RxErrors", R_canTelemetryPublishPeriod),
+            m_busOff(publisher, "CAN::BusOff", R_canTelemetryPublishPeriod),
+            m_txFull(publisher, "CAN::TxFull", R_canTelemetryPublishPeriod),
+            m_loopSpikesOut(publisher, "CAN::LoopSpikes", R_canTelemetryPublishPeriod),
+            m_loopSpikesWithErrorsOut(publisher, "CAN::LoopSpikesWithErrors", R_canTelemetryPublishPeriod),
+            m_lastSpikeOut(publisher, "CAN::LastSpike", R_canTelemetryPublishPeriod),
+            m_framesPerSecond(publisher, "CAN::FramesPerSecond", R_canTelemetryPublishPeriod) {
+
+            m_lastLoopTime = 0;
+            m_lastPublishTime = 0;
+            m_loopSpikes = 0;
+            m_loopSpikesWithErrors = 0;
+            m_lastSpike = "none";
+            //The bus is first read in update(), as this may be constructed
+            //before the HAL is up.
+            m_lastStatus = frc::CANStatus {};
+            m_lastSuppressed = 0;
+        }
+
+        void update() {
+
+            double now = frc::Timer::GetFPGATimestamp();
+            frc::CANStatus status = frc::RobotController::GetCANStatus();
+
+            //Check whether the last loop ran long, and if the bus was having
+            //trouble at the same time.
+            if (m_lastLoopTime != 0 && now - m_lastLoopTime > R_canTelemetryLoopSpikeTime) {
+
+                m_loopSpikes++;
+                std::ostringstream spike;
+                spike << std::fixed << std::setprecision(3) << now - m_lastLoopTime << "s";
+                bool errors = false;
+                errors |= describeRise(spike, "tx", status.transmitErrorCount, m_lastStatus.transmitErrorCount);
+                errors |= describeRise(spike, "rx", status.receiveErrorCount, m_lastStatus.receiveErrorCount);
+                errors |= describeRise(spike, "busOff", status.busOffCount, m_lastStatus.busOffCount);
+                errors |= describeRise(spike, "txFull", status.txFullCount, m_lastStatus.txFullCount);
+                if (errors) {
+
+                    m_loopSpikesWithErrors++;
+                }
+                m_lastSpike = spike.str();
+            }
+            m_lastLoopTime = now;
+            m_lastStatus = status;
+
+            if (now - m_lastPublishTime >= R_canTelemetryPublishPeriod) {
+
+                publish(now, status);
+            }
+        }
+
+    private:
+        static bool describeRise(std::ostringstream &out, const std::string &name, const int &count, const int &lastCount) {
+
+            if (count > lastCount) {
+
+                out << ' ' << name << "+" << count - lastCount;
+                return true;
+            }
+            return false;
+        }
+
+        void publish(const double &now, const frc::CANStatus &status) {
+
+            double elapsed = now - m_lastPublishTime;
+            const std::vector<CachedOutput*> &outputs = CachedOutput::getAll();
+            m_lastFramesSent.resize(outputs.size(), 0);
+
+            std::ostringstream frames;
+            frames << std::fixed << std::setprecision(1);
+            for (unsigned int i = 0; i < outputs.size(); ++i) {
+
+                long sent = outputs[i]->getFramesSent();
+                if (outputs[i]->isCAN()) {
+
+                    frames << outputs[i]->getName() << ':' << (sent - m_lastFramesSent[i]) / elapsed << ' ';
+                }
+                m_lastFramesSent[i] = sent;
+            }
+            long suppressed = CachedOutput::getTotalFramesSuppressed();
+            frames << "suppressed:" << (suppressed - m_lastSuppressed) / elapsed;
+            m_lastSuppressed = suppressed;
+
+            m_utilization.set(status.percentBusUtilization);
+            m_txErrors.set(status.transmitErrorCount);
+            m_rxErrors.set(status.receiveErrorCount);
+            m_busOff.set(status.busOffCount);
+            m_txFull.set(status.txFullCount);
+            m_loopSpikesOut.set(m_loopSpikes);
+            m_loopSpikesWithErrorsOut.set(m_loopSpikesWithErrors);
+            m_lastSpikeOut.set(m_lastSpike);
+            m_framesPerSecond.set(frames.str());
+            m_lastPublishTime = now;
+        }
+
+        double m_lastLoopTime;
+        double m_lastPublishTime;
+        frc::CANStatus m_lastStatus;
+        int m_loopSpikes;
+        int m_loopSpikesWithErrors;
+        std::string m_lastSpike;
+        std::vector<long> m_lastFramesSent;
+        long m_lastSuppressed;
+        DashboardNumber m_utilization;
+        DashboardNumber m_txErrors;
+        DashboardNumber m_rxErrors;
+        DashboardNumber m_busOff;
+        DashboardNumber m_txFull;
+        DashboardNumber m_loopSpikesOut;
+        DashboardNumber m_loopSpikesWithErrorsOut;
+        DashboardString m_lastSpikeOut;
+        DashboardString m_framesPerSecond;
+};
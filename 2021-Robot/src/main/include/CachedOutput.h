@@ -0,0 +1,247 @@
+/*
+class CachedOutput
+
+Wrappers around motor controllers and servos which only write a setpoint to
+the device when it differs from the last one written, or when the last write
+is older than R_outputKeepAlivePeriod (so a device which missed a frame is
+never left stale for long). Configuration writes, such as idle mode, are
+only sent on change. Every loop can then command every output without
+flooding the CAN bus with frames which change nothing.
+
+    CachedSparkMax(const int&, const rev::CANSparkMax::MotorType&, const StatusFramePeriods::Profile&)
+        Creates a SPARK MAX on the supplied CAN ID with the supplied motor
+        type, and sets its status frame periods for what will be read from
+        it. Set() and SetIdleMode() are cached; GetMotor() returns the
+        underlying controller for everything else (encoders, current).
+    CachedVictorSP(const int&)
+        Creates a Victor SP on the supplied PWM port. Set() is cached.
+    CachedServo(const int&)
+        Creates a servo on the supplied PWM port. Set() and SetAngle() are
+        cached.
+
+Public Methods (all)
+
+    const std::string& getName()
+        Returns the device's name with its ID, such as "SparkMax[10]".
+    bool isCAN()
+        Returns true if the device is on the CAN bus (rather than PWM).
+    long getFramesSent()
+        Returns how many writes this output has passed to its device.
+    long getFramesSuppressed()
+        Returns how many writes this output has skipped as unchanged.
+    static long getTotalFramesSent()
+    static long getTotalFramesSuppressed()
+        The same, summed over every output.
+    static const std::vector<CachedOutput*>& getAll()
+        Returns every output constructed so far, for telemetry.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <frc/Servo.h>
+#include <frc/Timer.h>
+#include <frc/VictorSP.h>
+#include <rev/CANSparkMax.h>
+
+#include "RobotMap.h"
+#include "StatusFramePeriods.h"
+
+class CachedOutput {
+
+    public:
+        const std::string& getName() {
+
+            return m_name;
+        }
+        bool isCAN() {
+
+            return m_isCAN;
+        }
+        long getFramesSent() {
+
+            return m_framesSent;
+        }
+        long getFramesSuppressed() {
+
+            return m_framesSuppressed;
+        }
+
+        static long getTotalFramesSent() {
+
+            return totalFramesSent();
+        }
+        static long getTotalFramesSuppressed() {
+
+            return totalFramesSuppressed();
+        }
+
+        static const std::vector<CachedOutput*>& getAll() {
+
+            return registry();
+        }
+
+    protected:
+        CachedOutput(const std::string &name, const bool &isCAN) {
+
+            m_name = name;
+            m_isCAN = isCAN;
+            registry().push_back(this);
+            m_hasValue = false;
+            m_lastValue = 0;
+            m_lastSentTime = 0;
+            m_framesSent = 0;
+            m_framesSuppressed = 0;
+        }
+
+        //Returns true (and remembers the value as sent) if the value should be
+        //written to the device, or counts it as suppressed otherwise.
+        bool shouldSend(const double &value) {
+
+            double now = frc::GetTime();
+            if (m_hasValue && value == m_lastValue && now - m_lastSentTime < R_outputKeepAlivePeriod) {
+
+                countSuppressed();
+                return false;
+            }
+            m_hasValue = true;
+            m_lastValue = value;
+            m_lastSentTime = now;
+            countSent();
+            return true;
+        }
+
+        void countSent() {
+
+            m_framesSent++;
+            totalFramesSent()++;
+        }
+
+        void countSuppressed() {
+
+            m_framesSuppressed++;
+            totalFramesSuppressed()++;
+        }
+
+    private:
+        static std::vector<CachedOutput*>& registry() {
+
+            static std::vector<CachedOutput*> outputs;
+            return outputs;
+        }
+        static std::atomic<long>& totalFramesSent() {
+
+            static std::atomic<long> total(0);
+            return total;
+        }
+        static std::atomic<long>& totalFramesSuppressed() {
+
+            static std::atomic<long> total(0);
+            return total;
+        }
+
+        std::string m_name;
+        bool m_isCAN;
+        bool m_hasValue;
+        double m_lastValue;
+        double m_lastSentTime;
+        long m_framesSent;
+        long m_framesSuppressed;
+};
+
+class CachedSparkMax : public CachedOutput {
+
+    public:
+        CachedSparkMax(const int &canID, const rev::CANSparkMax::MotorType &type, const StatusFramePeriods::Profile &statusFrames) : CachedOutput("SparkMax[" + std::to_string(canID) + "]", true) {
+
+            m_motor = new rev::CANSparkMax(canID, type);
+            StatusFramePeriods::apply(m_motor, statusFrames);
+            m_hasIdleMode = false;
+        }
+
+        void Set(const double &speed) {
+
+            if (shouldSend(speed)) {
+
+                m_motor->Set(speed);
+            }
+        }
+
+        void SetIdleMode(const rev::CANSparkMax::IdleMode &mode) {
+
+            //Idle mode is configuration, which the controller keeps, so it
+            //never needs to be resent.
+            if (m_hasIdleMode && mode == m_idleMode) {
+
+                countSuppressed();
+                return;
+            }
+            m_hasIdleMode = true;
+            m_idleMode = mode;
+            countSent();
+            m_motor->SetIdleMode(mode);
+        }
+
+        rev::CANSparkMax* GetMotor() {
+
+            return m_motor;
+        }
+
+    private:
+        rev::CANSparkMax *m_motor;
+        bool m_hasIdleMode;
+        rev::CANSparkMax::IdleMode m_idleMode;
+};
+
+class CachedVictorSP : public CachedOutput {
+
+    public:
+        CachedVictorSP(const int &pwmPort) : CachedOutput("VictorSP[" + std::to_string(pwmPort) + "]", false) {
+
+            m_motor = new frc::VictorSP(pwmPort);
+        }
+
+        void Set(const double &speed) {
+
+            if (shouldSend(speed)) {
+
+                m_motor->Set(speed);
+            }
+        }
+
+    private:
+        frc::VictorSP *m_motor;
+};
+
+class CachedServo : public CachedOutput {
+
+    public:
+        CachedServo(const int &pwmPort) : CachedOutput("Servo[" + std::to_string(pwmPort) + "]", false) {
+
+            m_servo = new frc::Servo(pwmPort);
+        }
+
+        //Both of these end up as the same position, so they share one cache,
+        //with angles stored as the position they become (0-180 to 0-1).
+        void Set(const double &position) {
+
+            if (shouldSend(position)) {
+
+                m_servo->Set(position);
+            }
+        }
+        void SetAngle(const double &angle) {
+
+            double clamped = angle < 0 ? 0 : (angle > 180 ? 180 : angle);
+            if (shouldSend(clamped / 180)) {
+
+                m_servo->SetAngle(clamped);
+            }
+        }
+
+    private:
+        frc::Servo *m_servo;
+};
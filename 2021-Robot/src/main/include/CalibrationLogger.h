@@ -0,0 +1,120 @@
+/*
+class CalibrationLogger
+
+Constructors
+
+    CalibrationLogger(const std::string&)
+        Creates a logger which appends launcher calibration shots to the CSV
+        file at the supplied path (on the USB stick, under /u/). The header
+        row is written if the file is new. Writes happen on a background
+        thread, so recording a shot never blocks the control loop.
+    ~CalibrationLogger()
+        Writes any shots still queued, then stops the background thread.
+
+Public Methods
+
+    void record(const double&, const double&, const double&, const double&, const double&, const bool&)
+        Queues a shot with the target area, flywheel RPM, hood servo angle,
+        launch speed, target vertical offset (ty), and whether it scored.
+        Rows use the same leading columns as the files in data/, so they can
+        be handed straight to the launcher refit tool.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <frc/DriverStation.h>
+
+class CalibrationLogger {
+
+    public:
+        CalibrationLogger(const std::string &path) {
+
+            m_path = path;
+            m_stopping = false;
+            m_writer = new std::thread(&CalibrationLogger::run, this);
+        }
+        ~CalibrationLogger() {
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stopping = true;
+            }
+            m_wake.notify_one();
+            m_writer->join();
+            delete m_writer;
+        }
+
+        void record(const double &area, const double &rpm, const double &servo, const double &launch, const double &ty, const bool &hit) {
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_pending.push_back({area, rpm, servo, launch, ty, hit});
+            }
+            m_wake.notify_one();
+        }
+
+    private:
+        struct Shot {
+
+            double area;
+            double rpm;
+            double servo;
+            double launch;
+            double ty;
+            bool hit;
+        };
+
+        void run() {
+
+            while (true) {
+
+                Shot shot;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_wake.wait(lock, [this] {return m_stopping || !m_pending.empty();});
+                    //Only stop once everything queued is written.
+                    if (m_pending.empty()) {
+
+                        return;
+                    }
+                    shot = m_pending.front();
+                    m_pending.pop_front();
+                }
+                //The file is reopened for every shot so that pulling the USB
+                //stick between shots never loses more than the one in flight.
+                std::ifstream existing(m_path);
+                bool isNew = !existing.good() || existing.peek() == std::ifstream::traits_type::eof();
+                existing.close();
+
+                std::ofstream file(m_path, std::ios::out | std::ios::app);
+                if (file.is_open()) {
+
+                    if (isNew) {
+
+                        file << "area,rpm,servo,launch,ty,hit\n";
+                    }
+                    file << std::setprecision(6) << shot.area << ',' << shot.rpm << ',' << shot.servo << ',' << shot.launch << ',' << shot.ty << ',' << (shot.hit ? 1 : 0) << '\n';
+                    file.close();
+                }
+                else {
+
+                    frc::DriverStation::ReportError("Unable to open " + m_path + " for calibration");
+                }
+            }
+        }
+
+        std::string m_path;
+        std::thread *m_writer;
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::deque<Shot> m_pending;
+        bool m_stopping;
+};
@@ -0,0 +1,122 @@
+/*
+class ChassisVelocityEstimator
+
+Constructors
+
+    ChassisVelocityEstimator(SensorSampler&)
+        Creates an estimator for Zion's translational velocity, measured
+        from its drive encoders and oriented with its NavX, both read from
+        the supplied sampler's frame.
+
+Public Methods
+
+    void update(const double&, const double&)
+        Takes the x and y translation last commanded to Zion, as passed to
+        SwerveTrain::Drive (field-oriented), and updates the estimate. Call
+        once per loop.
+    VectorDouble getVelocity()
+        Returns the estimated velocity in inches per second relative to the
+        robot, with i toward its right and j toward its front.
+    void reset()
+        Forgets the estimate, such as when Zion has been disabled.
+
+The speed comes from all four drive encoders, less Zion's turning. Each
+module moves at the translation plus its share of the turn, which is
+perpendicular to the module's position. The four positions cancel out, so
+the mean of the squared module speeds is the translation squared plus the
+turn squared. The turn is how far the NavX yaw moved, times
+R_zionModuleRadius. Modules may be reversed rather than turned, so their
+angles are not needed. The direction comes from the command, turned from the
+field into the robot's frame with the NavX yaw. The time is the frame's, so
+everything is measured over the time between samples.
+*/
+
+#pragma once
+
+#include <math.h>
+
+#include "RobotMap.h"
+#include "SensorSampler.h"
+#include "VectorDouble.h"
+
+class ChassisVelocityEstimator {
+
+    public:
+        ChassisVelocityEstimator(SensorSampler &refSensors) {
+
+            m_sensors = &refSensors;
+            reset();
+        }
+
+        void update(const double &x, const double &y) {
+
+            const SensorFrame &frame = m_sensors->getFrame();
+            double now = frame.time;
+            if (!m_initialized) {
+
+                remember(frame);
+                m_initialized = true;
+                return;
+            }
+            double dt = now - m_lastTime;
+            if (dt <= 0) {
+
+                return;
+            }
+            //Modules may be reversed rather than turned around, so only the
+            //magnitude of each encoder's travel is meaningful...
+            double squared = 0;
+            for (int module = 0; module < 4; ++module) {
+
+                double travel = (frame.drivePositions[module] - m_lastPositions[module]) / R_kuhnsConstant * R_circumfrenceWheel;
+                squared += travel * travel / 4;
+            }
+            //Less the turning, which every module shares equally...
+            double turn = remainder(frame.yaw - m_lastYaw, 360) * (M_PI / 180) * R_zionModuleRadius;
+            double speed = sqrt(fmax(0, squared - turn * turn)) / dt;
+            remember(frame);
+
+            //And the direction is that of the command, kept from the last
+            //command that had one while coasting to a stop.
+            VectorDouble command(x, y);
+            if (command.magnitude() > R_deadzoneController) {
+
+                m_direction = command.normalized();
+            }
+            //Turn the field-oriented direction into the robot's frame. Yaw is
+            //clockwise, so the field turns counterclockwise under the robot.
+            VectorDouble measured = m_direction.rotatedDeg(frame.yaw).scaled(speed);
+            m_velocity = m_velocity + (measured - m_velocity).scaled(R_zionVelocityFilterGain);
+        }
+
+        VectorDouble getVelocity() {
+
+            return m_velocity;
+        }
+
+        void reset() {
+
+            m_initialized = false;
+            m_direction = VectorDouble();
+            m_velocity = VectorDouble();
+        }
+
+    private:
+        void remember(const SensorFrame &frame) {
+
+            m_lastTime = frame.time;
+            m_lastYaw = frame.yaw;
+            for (int module = 0; module < 4; ++module) {
+
+                m_lastPositions[module] = frame.drivePositions[module];
+            }
+        }
+
+        SensorSampler* m_sensors;
+        bool m_initialized;
+        double m_lastTime;
+        double m_lastYaw;
+        double m_lastPositions[4];
+        VectorDouble m_direction;
+        VectorDouble m_velocity;
+};
@@ -0,0 +1,239 @@
+/*
+class ClimbSequence
+
+Constructors
+
+    ClimbSequence(Climber&, SensorSampler&, DashboardPublisher&)
+        Creates an automated climb for the supplied climber, which reads the
+        NavX roll from the supplied sampler and publishes its progress
+        through the supplied publisher.
+
+Public Methods
+
+    void start()
+        Begins the climb from the start, unless it is already running.
+    bool update()
+        Call once per loop, after the sampler's update, for as long as the
+        climb should continue. Drives the climber while running, and returns
+        true once the climb has finished.
+    void cancel()
+        Stops the climb where it is, with the climb and translate motors
+        stopped and the ratchet locked. Does nothing if not running.
+    bool isRunning()
+        Returns true between start() and the climb finishing or being
+        cancelled. While running, nothing else should drive the climber.
+
+The climb runs in four states:
+
+    kUnlock     Unlocks the ratchet and lifts gently for R_climbUnlockTime,
+                so that the pawl comes free.
+    kRaise      Raises at R_climbRaiseSpeed until either climb motor stalls
+                (draws R_climbStallCurrent for R_climbStallTime).
+    kBalance    Locks the ratchet, then translates along the bar against the
+                NavX roll until the robot hangs level.
+    kDone       Everything stopped and locked.
+
+Every state has a timeout, after which the climb moves on rather than
+waiting forever. The time spent in each state and in the whole climb is
+printed to the driver station, and the current state and time published to
+the SmartDashboard as Climb::State and Climb::Time.
+*/
+
+#pragma once
+
+#include <math.h>
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include <frc/DriverStation.h>
+
+#include "Climber.h"
+#include "DashboardPublisher.h"
+#include "RobotMap.h"
+#include "SensorSampler.h"
+
+class ClimbSequence {
+
+    public:
+        ClimbSequence(Climber &refClimber, SensorSampler &refSensors, DashboardPublisher &publisher) :
+            m_stateOut(publisher, "Climb::State", R_dashboardFlushPeriod),
+            m_timeOut(publisher, "Climb::Time", R_dashboardFlushPeriod) {
+
+            m_climber = &refClimber;
+            m_sensors = &refSensors;
+            m_state = kDone;
+            m_running = false;
+            m_startTime = 0;
+            m_stateTime = 0;
+            m_conditionTime = 0;
+            m_stateOut.set(GetName(m_state));
+        }
+
+        void start() {
+
+            if (m_running) {
+
+                return;
+            }
+            m_running = true;
+            m_startTime = m_sensors->getFrame().time;
+            m_report.str("");
+            enterState(kUnlock);
+        }
+
+        bool update() {
+
+            if (!m_running) {
+
+                return false;
+            }
+            const SensorFrame &frame = m_sensors->getFrame();
+            double inState = frame.time - m_stateTime;
+            switch (m_state) {
+
+                case kUnlock:
+                    m_climber->lock(false);
+                    m_climber->setSpeed(Climber::Motor::kClimb, R_climbUnlockSpeed);
+                    if (inState >= R_climbUnlockTime) {
+
+                        enterState(kRaise);
+                    }
+                    break;
+
+                case kRaise:
+                    m_climber->lock(false);
+                    m_climber->setSpeed(Climber::Motor::kClimb, R_climbRaiseSpeed);
+                    //Only a stall which lasts counts, so that the surge of
+                    //starting at full speed does not.
+                    if (m_climber->getClimbCurrent() < R_climbStallCurrent) {
+
+                        m_conditionTime = frame.time;
+                    }
+                    if (frame.time - m_conditionTime >= R_climbStallTime) {
+
+                        enterState(kBalance);
+                    }
+                    else if (inState >= R_climbRaiseTimeout) {
+
+                        frc::DriverStation::ReportError("Climb: no stall after " + std::to_string(R_climbRaiseTimeout) + " seconds of raising");
+                        enterState(kBalance);
+                    }
+                    break;
+
+                case kBalance:
+                    m_climber->lock(true);
+                    m_climber->setSpeed(Climber::Motor::kClimb, 0);
+                    if (fabs(frame.roll) > R_climbBalanceTolerance) {
+
+                        m_conditionTime = frame.time;
+                        double speed = frame.roll * R_climbBalanceGain;
+                        m_climber->setSpeed(Climber::Motor::kTranslate, fmax(-R_climbBalanceMaxSpeed, fmin(R_climbBalanceMaxSpeed, speed)));
+                    }
+                    else {
+
+                        m_climber->setSpeed(Climber::Motor::kTranslate, 0);
+                    }
+                    if (frame.time - m_conditionTime >= R_climbBalanceSettleTime) {
+
+                        enterState(kDone);
+                    }
+                    else if (inState >= R_climbBalanceTimeout) {
+
+                        frc::DriverStation::ReportError("Climb: not level after " + std::to_string(R_climbBalanceTimeout) + " seconds of balancing");
+                        enterState(kDone);
+                    }
+                    break;
+
+                case kDone:
+                    break;
+            }
+            if (m_state == kDone) {
+
+                finish("Climb: finished");
+                return true;
+            }
+            m_timeOut.set(frame.time - m_startTime);
+            return false;
+        }
+
+        void cancel() {
+
+            if (!m_running) {
+
+                return;
+            }
+            enterState(kDone);
+            finish("Climb: cancelled");
+        }
+
+        bool isRunning() {
+
+            return m_running;
+        }
+
+    private:
+        enum State {
+
+            kUnlock,
+            kRaise,
+            kBalance,
+            kDone
+        };
+
+        static std::string GetName(const State &state) {
+
+            switch (state) {
+
+                case kUnlock: return "Unlock";
+                case kRaise: return "Raise";
+                case kBalance: return "Balance";
+                default: return "Done";
+            }
+        }
+
+        void enterState(const State &state) {
+
+            double now = m_sensors->getFrame().time;
+            if (m_running && m_state != kDone && state != m_state) {
+
+                m_report << std::fixed << std::setprecision(2) << " " << GetName(m_state) << " " << now - m_stateTime;
+            }
+            m_state = state;
+            m_stateTime = now;
+            m_conditionTime = now;
+            m_stateOut.set(GetName(state));
+            if (state == kDone) {
+
+                m_climber->setSpeed(Climber::Motor::kClimb, 0);
+                m_climber->setSpeed(Climber::Motor::kTranslate, 0);
+                m_climber->setSpeed(Climber::Motor::kWheel, 0);
+                m_climber->lock(true);
+            }
+        }
+
+        void finish(const std::string &outcome) {
+
+            double total = m_sensors->getFrame().time - m_startTime;
+            std::ostringstream message;
+            message << std::fixed << std::setprecision(2) << outcome << " in " << total << " seconds (" << m_report.str().substr(m_report.str().empty() ? 0 : 1) << ")";
+            frc::DriverStation::ReportError(message.str());
+            m_timeOut.set(total);
+            m_running = false;
+        }
+
+        Climber *m_climber;
+        SensorSampler *m_sensors;
+        DashboardString m_stateOut;
+        DashboardNumber m_timeOut;
+        State m_state;
+        bool m_running;
+        double m_startTime;
+        double m_stateTime;
+        //When the state's condition (a stall, or being level) was last not
+        //met.
+        double m_conditionTime;
+        //Each state's time, in order, for the driver station.
+        std::ostringstream m_report;
+};
@@ -12,6 +12,9 @@ Constructors
 
 Public Methods
 
+    void start()
+        Starts watching the bottom limit switch by interrupt. Call from
+        RobotInit.
     void setSpeed(const int&, const double& = 0)
         Sets the speed of the supplied LiftMotor to the passed double
         (defaults to 0).
@@ -19,32 +22,61 @@ Public Methods
         If true, locks the climber in the up direction. If false or null,
         unlocks it. Persists across calls (it's hardware ;)). Defaults to
         locking.
+    bool isAtBottom()
+        Returns true if the bottom limit switch is pressed.
+    double getClimbCurrent()
+        Returns the output current in amps of whichever climb motor is
+        drawing more.
+    uint32_t getBottomCuts()
+        Returns how many times the climb motors have been cut by the bottom
+        limit switch closing while driving down.
 
     enum LiftMotor
         Used to select which motor the set function operates on.
+
+While R_climberBottomLimitEnabled, the climb motors are never driven down
+with the bottom switch pressed. The switch is watched by interrupt, so they
+are cut the moment it closes, from the interrupt thread, rather than at the
+next call to setSpeed.
 */
 
 #pragma once
 
+#include <stdint.h>
+
+#include <atomic>
+#include <mutex>
+
 #include <frc/DigitalInput.h>
-#include <frc/Servo.h>
-#include <frc/VictorSP.h>
 #include "rev/CANSparkMax.h"
 
+#include "CachedOutput.h"
+#include "DigitalEdge.h"
+#include "RobotMap.h"
+
 class Climber {
 
     public:
         Climber(const int &canForwardID, const int &canRearID, const int &translateMotorPWMPort, const int &wheelMotorPWMPort, const int &servoPWMPort, const int &limitDIOPort) {
 
-            m_forwardClimbMotor = new rev::CANSparkMax(canForwardID, rev::CANSparkMax::MotorType::kBrushed);
-            m_rearClimbMotor = new rev::CANSparkMax(canRearID, rev::CANSparkMax::MotorType::kBrushed);
+            m_forwardClimbMotor = new CachedSparkMax(canForwardID, rev::CANSparkMax::MotorType::kBrushed, StatusFramePeriods::kCurrentSensed);
+            m_rearClimbMotor = new CachedSparkMax(canRearID, rev::CANSparkMax::MotorType::kBrushed, StatusFramePeriods::kCurrentSensed);
 
-            m_translateMotor = new frc::VictorSP(translateMotorPWMPort);
-            m_wheelMotor = new frc::VictorSP(wheelMotorPWMPort);
+            m_translateMotor = new CachedVictorSP(translateMotorPWMPort);
+            m_wheelMotor = new CachedVictorSP(wheelMotorPWMPort);
 
-            m_ratchetServo = new frc::Servo(servoPWMPort);
+            m_ratchetServo = new CachedServo(servoPWMPort);
 
             m_limitBottom = new frc::DigitalInput(limitDIOPort);
+            m_bottom = new DigitalEdge(*m_limitBottom);
+            m_bottom->onChange([this](bool pressed, double) { bottomChanged(pressed); });
+            m_climbSpeed = 0;
+            m_bottomCuts = 0;
+        }
+
+        void start() {
+
+            m_bottom->start();
         }
 
         void setSpeed(const int &motor, double speedToSet = 0) {
@@ -52,33 +84,13 @@ class Climber {
             switch (motor) {
 
                 case Motor::kClimb:
-                    // Nolan told me to bypass the limit switch
-                    //    |
-                    //    |
-                    //    |
-                    //   \ /
-                    //    v
-                    //=========================================================
-                    //If a downward direction is wanted, do not allow it to
-                    //happen if the bottom position is already reached.
-                    /*if (speedToSet < 0) {
-
-                        //Switches are normally open, so invert.
-                        if (!m_limitBottom->Get()) {
-
-                            speedToSet = 0;
-                        }
-                    }*/
-                    //=========================================================
-                    m_forwardClimbMotor->Set(speedToSet);
-                    m_rearClimbMotor->Set(speedToSet);
+                    setClimbSpeed(speedToSet);
                     break;
                 //This motor is mounted upside-down, so invert it.
                 case Motor::kTranslate: m_translateMotor->Set(-speedToSet); break;
                 case Motor::kWheel: m_wheelMotor->Set(speedToSet); break;
                 case Motor::kAll:
-                    m_forwardClimbMotor->Set(speedToSet);
-                    m_rearClimbMotor->Set(speedToSet);
+                    setClimbSpeed(speedToSet);
                     m_translateMotor->Set(speedToSet);
                     m_wheelMotor->Set(speedToSet);
                     break;
@@ -97,19 +109,71 @@ class Climber {
             }
         }
 
+        bool isAtBottom() {
+
+            return m_bottom->isPressed();
+        }
+        double getClimbCurrent() {
+
+            double forward = m_forwardClimbMotor->GetMotor()->GetOutputCurrent();
+            double rear = m_rearClimbMotor->GetMotor()->GetOutputCurrent();
+            return forward > rear ? forward : rear;
+        }
+        uint32_t getBottomCuts() {
+
+            return m_bottomCuts.load();
+        }
+
         enum Motor {
 
             kClimb, kTranslate, kWheel, kAll
         };
 
     private:
-        rev::CANSparkMax *m_forwardClimbMotor;
-        rev::CANSparkMax *m_rearClimbMotor;
+        void setClimbSpeed(double speedToSet) {
 
-        frc::VictorSP *m_translateMotor;
-        frc::VictorSP *m_wheelMotor;
+            std::lock_guard<std::mutex> lock(m_climbMutex);
+            //If a downward direction is wanted, do not allow it to happen if
+            //the bottom position is already reached.
+            if (R_climberBottomLimitEnabled && speedToSet < 0 && m_bottom->isPressed()) {
 
-        frc::Servo *m_ratchetServo;
+                speedToSet = 0;
+            }
+            m_climbSpeed = speedToSet;
+            m_forwardClimbMotor->Set(speedToSet);
+            m_rearClimbMotor->Set(speedToSet);
+        }
+
+        //Runs on the interrupt thread.
+        void bottomChanged(const bool &pressed) {
+
+            if (!R_climberBottomLimitEnabled || !pressed) {
+
+                return;
+            }
+            std::lock_guard<std::mutex> lock(m_climbMutex);
+            if (m_climbSpeed < 0) {
+
+                m_climbSpeed = 0;
+                m_forwardClimbMotor->Set(0);
+                m_rearClimbMotor->Set(0);
+                m_bottomCuts++;
+            }
+        }
+
+        CachedSparkMax *m_forwardClimbMotor;
+        CachedSparkMax *m_rearClimbMotor;
+
+        CachedVictorSP *m_translateMotor;
+        CachedVictorSP *m_wheelMotor;
+
+        CachedServo *m_ratchetServo;
 
         frc::DigitalInput *m_limitBottom;
+        DigitalEdge *m_bottom;
+
+        //Guards the climb motors, which the interrupt thread may cut.
+        std::mutex m_climbMutex;
+        double m_climbSpeed;
+        std::atomic<uint32_t> m_bottomCuts;
 };
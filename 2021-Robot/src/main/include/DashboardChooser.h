@@ -0,0 +1,72 @@
+/*
+class DashboardChooser
+
+Constructors
+
+    DashboardChooser(const std::string&, frc::SendableChooser<std::string>*)
+        Puts the supplied chooser (with its options already added) on the
+        SmartDashboard under the supplied name, and listens for its
+        selection to change.
+
+Public Methods
+
+    bool refresh()
+        Re-reads the selection only if the dashboard has changed it since
+        the last refresh, and returns whether it did. Call once per loop.
+    const std::string& getSelected()
+        Returns the selection as of the last refresh.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include <frc/smartdashboard/SendableChooser.h>
+#include <frc/smartdashboard/SmartDashboard.h>
+#include <networktables/NetworkTableEntry.h>
+#include <networktables/NetworkTableInstance.h>
+
+class DashboardChooser {
+
+    public:
+        DashboardChooser(const std::string &name, frc::SendableChooser<std::string> *chooser) : m_changed(true) {
+
+            m_chooser = chooser;
+            frc::SmartDashboard::PutData(name, m_chooser);
+            //The dashboard writes its choice to the chooser's "selected"
+            //entry, so a change there is the only time the selection can be
+            //different.
+            m_entry = nt::NetworkTableInstance::GetDefault().GetEntry("/SmartDashboard/" + name + "/selected");
+            m_entry.AddListener([this](const nt::EntryNotification&) {
+
+                m_changed = true;
+            }, NT_NOTIFY_NEW | NT_NOTIFY_UPDATE | NT_NOTIFY_LOCAL);
+        }
+
+        bool refresh() {
+
+            if (!m_changed.exchange(false)) {
+
+                return false;
+            }
+            std::string selected = m_chooser->GetSelected();
+            if (selected == m_selected) {
+
+                return false;
+            }
+            m_selected = selected;
+            return true;
+        }
+
+        const std::string& getSelected() {
+
+            return m_selected;
+        }
+
+    private:
+        frc::SendableChooser<std::string> *m_chooser;
+        nt::NetworkTableEntry m_entry;
+        std::atomic<bool> m_changed;
+        std::string m_selected;
+};
@@ -0,0 +1,192 @@
+/*
+class DashboardPublisher
+
+Constructors
+
+    DashboardPublisher()
+        Creates a publisher with nothing registered.
+
+Public Methods
+
+    int addNumber(const std::string&, const double&)
+    int addString(const std::string&, const double&)
+        Registers a SmartDashboard key with the shortest period in seconds
+        between its writes (0 for every flush), and returns its id. Keys
+        are looked up on the first flush, so these are safe to call before
+        NetworkTables is up.
+    void setNumber(const int&, const double&)
+    void setString(const int&, const std::string&)
+        Stores the signal's latest value locally. This touches no
+        NetworkTables state, so it is free to call every loop.
+    void update()
+        Call once per loop (from RobotPeriodic). Every
+        R_dashboardFlushPeriod, writes all signals which have changed and
+        whose periods have passed, together; the rest wait for a later
+        flush, so a signal which changes every loop is written once per its
+        period with its latest value.
+
+class DashboardNumber
+class DashboardString
+
+    DashboardNumber(DashboardPublisher&, const std::string&, const double&)
+    DashboardString(DashboardPublisher&, const std::string&, const double&)
+        Registers a key with the supplied publisher and period.
+    void set(const double&)
+    void set(const std::string&)
+        Stores its value.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <frc/smartdashboard/SmartDashboard.h>
+#include <frc/Timer.h>
+#include <networktables/NetworkTableEntry.h>
+
+#include "RobotMap.h"
+
+class DashboardPublisher {
+
+    public:
+        DashboardPublisher() {
+
+            m_lastFlush = 0;
+        }
+
+        int addNumber(const std::string &key, const double &period) {
+
+            return add(key, period, false);
+        }
+        int addString(const std::string &key, const double &period) {
+
+            return add(key, period, true);
+        }
+
+        void setNumber(const int &id, const double &value) {
+
+            Signal &signal = m_signals[id];
+            if (value != signal.number) {
+
+                signal.number = value;
+                signal.changed = true;
+            }
+        }
+        void setString(const int &id, const std::string &value) {
+
+            Signal &signal = m_signals[id];
+            if (value != signal.string) {
+
+                signal.string = value;
+                signal.changed = true;
+            }
+        }
+
+        void update() {
+
+            double now = frc::Timer::GetFPGATimestamp();
+            if (now - m_lastFlush < R_dashboardFlushPeriod) {
+
+                return;
+            }
+            m_lastFlush = now;
+
+            for (Signal &signal : m_signals) {
+
+                if (!signal.changed || now - signal.lastWrite < signal.period) {
+
+                    continue;
+                }
+                if (!signal.found) {
+
+                    signal.entry = frc::SmartDashboard::GetEntry(signal.key);
+                    signal.found = true;
+                }
+                if (signal.isString) {
+
+                    signal.entry.SetString(signal.string);
+                }
+                else {
+
+                    signal.entry.SetDouble(signal.number);
+                }
+                signal.lastWrite = now;
+                signal.changed = false;
+            }
+        }
+
+    private:
+        struct Signal {
+
+            std::string key;
+            nt::NetworkTableEntry entry;
+            bool found;
+            bool isString;
+            double period;
+            double lastWrite;
+            double number;
+            std::string string;
+            bool changed;
+        };
+
+        int add(const std::string &key, const double &period, const bool &isString) {
+
+            Signal signal;
+            signal.key = key;
+            signal.found = false;
+            signal.isString = isString;
+            signal.period = period;
+            //Far enough back that the first value is written at the next
+            //flush.
+            signal.lastWrite = -period;
+            signal.number = 0;
+            signal.string = "";
+            //Written once, so the key appears on the dashboard even if its
+            //value never changes.
+            signal.changed = true;
+            m_signals.push_back(signal);
+            return m_signals.size() - 1;
+        }
+
+        double m_lastFlush;
+        std::vector<Signal> m_signals;
+};
+
+class DashboardNumber {
+
+    public:
+        DashboardNumber(DashboardPublisher &publisher, const std::string &key, const double &period) {
+
+            m_publisher = &publisher;
+            m_id = publisher.addNumber(key, period);
+        }
+
+        void set(const double &value) {
+
+            m_publisher->setNumber(m_id, value);
+        }
+
+    private:
+        DashboardPublisher *m_publisher;
+        int m_id;
+};
+
+class DashboardString {
+
+    public:
+        DashboardString(DashboardPublisher &publisher, const std::string &key, const double &period) {
+
+            m_publisher = &publisher;
+            m_id = publisher.addString(key, period);
+        }
+
+        void set(const std::string &value) {
+
+            m_publisher->setString(m_id, value);
+        }
+
+    private:
+        DashboardPublisher *m_publisher;
+        int m_id;
+};
@@ -0,0 +1,51 @@
+/*
+class DashboardTunable
+
+Constructors
+
+    DashboardTunable(const std::string&, const double&)
+        Puts a number on the SmartDashboard under the supplied key with the
+        supplied default, and listens for it to be changed.
+
+Public Methods
+
+    double get()
+        Returns the latest value from the dashboard. This is a read of
+        memory, updated by NetworkTables only when the value changes, so it
+        is free to call every loop (unlike SmartDashboard::GetNumber).
+*/
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include <frc/smartdashboard/SmartDashboard.h>
+#include <networktables/NetworkTableEntry.h>
+
+class DashboardTunable {
+
+    public:
+        DashboardTunable(const std::string &key, const double &defaultValue) : m_value(defaultValue) {
+
+            frc::SmartDashboard::PutNumber(key, defaultValue);
+            m_entry = frc::SmartDashboard::GetEntry(key);
+            //Listeners run on the NetworkTables thread, hence the atomic.
+            m_entry.AddListener([this](const nt::EntryNotification &notification) {
+
+                if (notification.value && notification.value->IsDouble()) {
+
+                    m_value = notification.value->GetDouble();
+                }
+            }, NT_NOTIFY_IMMEDIATE | NT_NOTIFY_NEW | NT_NOTIFY_UPDATE | NT_NOTIFY_LOCAL);
+        }
+
+        double get() {
+
+            return m_value;
+        }
+
+    private:
+        nt::NetworkTableEntry m_entry;
+        std::atomic<double> m_value;
+};
@@ -0,0 +1,145 @@
+/*
+class DigitalEdge
+
+Constructors
+
+    DigitalEdge(frc::DigitalInput&, const bool& = true)
+        Creates an edge watcher for the switch on the supplied input, which
+        is normally open (pressed when the input reads false) unless false
+        is passed. Nothing is watched until start().
+
+Public Methods
+
+    void start()
+        Asks the FPGA to interrupt on both edges of the input, and handles
+        each on WPILib's interrupt thread as it happens. Call from RobotInit.
+    void onChange(std::function<void(bool, double)>)
+        Sets a function called on the interrupt thread whenever the switch
+        changes, with whether it is now pressed and the FPGA time in seconds
+        of the edge. Every bounce is passed on, so it should be cheap and
+        safe to repeat. Set before start().
+    bool isPressed()
+        Returns whether the switch was pressed as of its latest edge.
+    uint32_t getPresses()
+        Returns how many presses have been counted since start(). A press
+        only counts if the switch was quiet for R_switchDebounceTime before
+        it, so contact bounce is not counted. Compare against an earlier
+        count to find whether it has been pressed since.
+    double getPressTime()
+        Returns the FPGA time in seconds of the last counted press.
+
+The pressed state follows every edge, so that whatever acts on it (such as
+cutting the climber) does so within the interrupt's latency, well under a
+millisecond, rather than waiting for the next loop. Only counting presses is
+debounced. Edge times are the FPGA's timestamps of the edges, not of when
+they were handled.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+
+#include <frc/DigitalInput.h>
+
+#include "RobotMap.h"
+
+class DigitalEdge {
+
+    public:
+        DigitalEdge(frc::DigitalInput &refInput, const bool &normallyOpen = true) {
+
+            m_input = &refInput;
+            m_normallyOpen = normallyOpen;
+            m_started = false;
+            m_pressed = false;
+            m_presses = 0;
+            m_pressTime = 0;
+            m_lastEdgeTime = -R_switchDebounceTime;
+        }
+
+        void start() {
+
+            if (m_started) {
+
+                return;
+            }
+            m_started = true;
+            m_pressed = isPressedLevel(m_input->Get());
+            m_input->RequestInterrupts([this](frc::InterruptableSensorBase::WaitResult result) { handle(result); });
+            m_input->SetUpSourceEdge(true, true);
+            m_input->EnableInterrupts();
+        }
+
+        void onChange(std::function<void(bool, double)> callback) {
+
+            m_onChange = callback;
+        }
+
+        bool isPressed() {
+
+            return m_pressed.load();
+        }
+        uint32_t getPresses() {
+
+            return m_presses.load();
+        }
+        double getPressTime() {
+
+            return m_pressTime.load();
+        }
+
+    private:
+        bool isPressedLevel(const bool &level) {
+
+            return m_normallyOpen ? !level : level;
+        }
+
+        //Runs on the interrupt thread.
+        void handle(const frc::InterruptableSensorBase::WaitResult &result) {
+
+            bool rising = result & frc::InterruptableSensorBase::kRisingEdge;
+            bool falling = result & frc::InterruptableSensorBase::kFallingEdge;
+            if (!rising && !falling) {
+
+                return;
+            }
+            double risingTime = rising ? m_input->ReadRisingTimestamp() : 0;
+            double fallingTime = falling ? m_input->ReadFallingTimestamp() : 0;
+            //If both edges came before this was handled, only the input
+            //itself knows which was last.
+            bool level = rising && falling ? m_input->Get() : rising;
+            double time = risingTime > fallingTime ? risingTime : fallingTime;
+
+            bool pressed = isPressedLevel(level);
+            bool quiet = time - m_lastEdgeTime >= R_switchDebounceTime;
+            m_lastEdgeTime = time;
+            if (pressed == m_pressed.load()) {
+
+                return;
+            }
+            m_pressed = pressed;
+            if (pressed && quiet) {
+
+                m_pressTime = time;
+                m_presses++;
+            }
+            if (m_onChange) {
+
+                m_onChange(pressed, time);
+            }
+        }
+
+        frc::DigitalInput *m_input;
+        bool m_normallyOpen;
+        bool m_started;
+        std::function<void(bool, double)> m_onChange;
+
+        //Only the interrupt thread writes these once started.
+        double m_lastEdgeTime;
+        std::atomic<bool> m_pressed;
+        std::atomic<uint32_t> m_presses;
+        std::atomic<double> m_pressTime;
+};
@@ -0,0 +1,256 @@
+/*
+class DriveController
+
+Constructors
+
+    DriveController(SwerveTrain&, DashboardPublisher&)
+        Creates a controller for Zion, which publishes its timing through
+        the supplied publisher. Nothing is driven until start().
+
+Public Methods
+
+    void start()
+        Starts the control loop on a Notifier every R_driveControlPeriod,
+        whose thread runs at real-time priority R_driveControlPriority on
+        the robot.
+    void drive(const double&, const double&, const double&, const bool&, const bool&, const bool&, const double& = 1.0)
+        Posts a setpoint with the same arguments as SwerveTrain::Drive. The
+        control loop passes the latest setpoint to Drive every period until
+        another is posted, or stops Zion if none has been posted for
+        R_driveCommandTimeout.
+    void stop()
+        Posts a stop, which the control loop applies once.
+    void update()
+        Call once per loop (from RobotPeriodic). Every
+        R_driveControlPublishPeriod, publishes to the SmartDashboard:
+
+        Drive::Rate          How many times per second the loop ran.
+        Drive::WorstJitter   The furthest in milliseconds any period was
+                             from R_driveControlPeriod.
+        Drive::Timeouts      How many times Zion has been stopped for want
+                             of a setpoint.
+
+class DriveController::Direct
+
+    Direct(DriveController&)
+        Takes Zion back from the control loop for as long as the Direct
+        exists, so that SwerveTrain may be called directly (such as by auto
+        steps, or to zero the modules). The control loop stays idle after
+        it ends, until the next setpoint or stop is posted.
+
+Setpoints pass from the main loop through a SeqLock, so posting one never
+waits on the control loop, and the control loop only tries a few times to
+read one rather than spin on the main loop it may have preempted. The
+control loop holds a lock on Zion only while it drives it, which only
+Direct contends for.
+*/
+
+#pragma once
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+#include <frc/Notifier.h>
+#include <frc/RobotBase.h>
+#include <frc/Timer.h>
+#include <units/time.h>
+
+#include "DashboardPublisher.h"
+#include "RobotMap.h"
+#include "SeqLock.h"
+#include "SwerveTrain.h"
+
+class DriveController {
+
+    public:
+        class Direct {
+
+            public:
+                Direct(DriveController &controller) {
+
+                    controller.post(kIdle);
+                    m_lock = std::unique_lock<std::mutex>(controller.m_zionMutex);
+                }
+
+            private:
+                std::unique_lock<std::mutex> m_lock;
+        };
+
+        DriveController(SwerveTrain &refZion, DashboardPublisher &publisher) :
+            m_rateOut(publisher, "Drive::Rate", R_driveControlPublishPeriod),
+            m_worstJitterOut(publisher, "Drive::WorstJitter", R_driveControlPublishPeriod),
+            m_timeoutsOut(publisher, "Drive::Timeouts", R_driveControlPublishPeriod),
+            m_ticks(0),
+            m_worstJitter(0),
+            m_timeouts(0) {
+
+            m_zion = &refZion;
+            m_notifier = nullptr;
+            m_posted = 0;
+            m_command = Command();
+            m_applied = 0;
+            m_timedOut = 0;
+            m_lastTick = std::chrono::steady_clock::time_point();
+            m_lastPublish = 0;
+        }
+
+        void start() {
+
+            if (m_notifier != nullptr) {
+
+                return;
+            }
+            if (frc::RobotBase::IsReal()) {
+
+                //The callback runs on the Notifier's own thread, which is the
+                //one that must be real-time. The HAL's notifier thread which
+                //wakes it is raised too, so that the wake-up is not late.
+                frc::Notifier::SetHALThreadPriority(true, R_driveControlPriority);
+                m_notifier = new frc::Notifier(R_driveControlPriority, [this] { tick(); });
+            }
+            else {
+
+                m_notifier = new frc::Notifier([this] { tick(); });
+            }
+            m_notifier->StartPeriodic(units::second_t(R_driveControlPeriod));
+        }
+
+        void drive(const double &x, const double &y, const double &z, const bool &precision, const bool &optionTwo, const bool &optionThree, const double &throttle = 1.0) {
+
+            Command command = Command();
+            command.mode = kDrive;
+            command.x = x;
+            command.y = y;
+            command.z = z;
+            command.options[0] = precision;
+            command.options[1] = optionTwo;
+            command.options[2] = optionThree;
+            command.throttle = throttle;
+            post(command);
+        }
+        void stop() {
+
+            post(kStop);
+        }
+
+        void update() {
+
+            double now = frc::Timer::GetFPGATimestamp();
+            if (now - m_lastPublish < R_driveControlPublishPeriod) {
+
+                return;
+            }
+            m_rateOut.set(m_ticks.exchange(0) / (now - m_lastPublish));
+            m_worstJitterOut.set(m_worstJitter.exchange(0) / 1e3);
+            m_timeoutsOut.set(m_timeouts.load());
+            m_lastPublish = now;
+        }
+
+    private:
+        enum Mode {
+
+            kIdle,
+            kDrive,
+            kStop
+        };
+
+        struct Command {
+
+            Mode mode;
+            //Counts posts, so that a stop (or a timeout) is only applied
+            //once.
+            uint32_t serial;
+            double time;
+            double x;
+            double y;
+            double z;
+            bool options[3];
+            double throttle;
+        };
+
+        void post(const Mode &mode) {
+
+            Command command = Command();
+            command.mode = mode;
+            post(command);
+        }
+        void post(Command command) {
+
+            command.serial = ++m_posted;
+            command.time = frc::Timer::GetFPGATimestamp();
+            m_mailbox.write(command);
+        }
+
+        //Runs on the Notifier's thread.
+        void tick() {
+
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            if (m_lastTick != std::chrono::steady_clock::time_point()) {
+
+                long period = std::chrono::duration_cast<std::chrono::microseconds>(now - m_lastTick).count();
+                long jitter = labs(period - (long)(R_driveControlPeriod * 1e6));
+                if (jitter > m_worstJitter.load(std::memory_order_relaxed)) {
+
+                    m_worstJitter.store(jitter, std::memory_order_relaxed);
+                }
+            }
+            m_lastTick = now;
+            m_ticks++;
+
+            //If the main loop is mid-post, keep the last setpoint.
+            m_mailbox.tryRead(m_command);
+
+            std::lock_guard<std::mutex> lock(m_zionMutex);
+            if (m_command.mode == kDrive && frc::Timer::GetFPGATimestamp() - m_command.time > R_driveCommandTimeout) {
+
+                //The main loop has stopped posting; don't drive on without
+                //it.
+                if (m_timedOut != m_command.serial) {
+
+                    m_zion->Stop();
+                    m_timedOut = m_command.serial;
+                    m_timeouts++;
+                }
+                return;
+            }
+            switch (m_command.mode) {
+
+                case kDrive:
+                    m_zion->Drive(m_command.x, m_command.y, m_command.z, m_command.options[0], m_command.options[1], m_command.options[2], m_command.throttle);
+                    break;
+                case kStop:
+                    if (m_applied != m_command.serial) {
+
+                        m_zion->Stop();
+                    }
+                    break;
+                case kIdle:
+                    break;
+            }
+            m_applied = m_command.serial;
+        }
+
+        SwerveTrain *m_zion;
+        frc::Notifier *m_notifier;
+        std::mutex m_zionMutex;
+
+        //Written only by the main loop.
+        SeqLock<Command> m_mailbox;
+        uint32_t m_posted;
+        double m_lastPublish;
+        DashboardNumber m_rateOut;
+        DashboardNumber m_worstJitterOut;
+        DashboardNumber m_timeoutsOut;
+
+        //Written only by the control loop.
+        Command m_command;
+        uint32_t m_applied;
+        uint32_t m_timedOut;
+        std::chrono::steady_clock::time_point m_lastTick;
+        std::atomic<long> m_ticks;
+        std::atomic<long> m_worstJitter;
+        std::atomic<long> m_timeouts;
+};
@@ -0,0 +1,123 @@
+/*
+struct DriverInputs
+
+Public Functions
+
+    static DriverInputs sample(frc::XboxController&, frc::XboxController&, frc::Joystick&)
+        Reads every axis and button used by the robot from P1, P2, and P3
+        (the joystick alternative to P1) exactly once. Sample at the start of
+        each loop and read from the result thereafter, so that every decision
+        in a loop is made from the same instant and the controllers are not
+        polled over and over.
+
+Members are named by player, then by control. Edge-triggered members
+(...Pressed) are only true in the one sample taken after the press.
+*/
+
+#pragma once
+
+#include <frc/Joystick.h>
+#include <frc/XboxController.h>
+
+struct DriverInputs {
+
+    struct PlayerOne {
+
+        double leftX;
+        double leftY;
+        double rightX;
+        bool leftBumper;
+        bool buttonA;
+        bool buttonB;
+        bool buttonX;
+        bool buttonY;
+    };
+
+    struct PlayerTwo {
+
+        double leftX;
+        double leftY;
+        double rightX;
+        double rightY;
+        double leftTrigger;
+        double rightTrigger;
+        bool leftBumper;
+        bool leftBumperPressed;
+        bool rightBumper;
+        bool rightBumperPressed;
+        bool buttonA;
+        bool buttonAPressed;
+        bool buttonX;
+        bool buttonY;
+        bool buttonBack;
+        bool buttonStart;
+        bool button9;
+        int pov;
+    };
+
+    struct PlayerThree {
+
+        double x;
+        double y;
+        double z;
+        double throttle;
+        bool button2;
+        bool button3;
+        bool button4;
+        bool button5;
+        bool button6;
+        bool button7;
+        bool button12;
+    };
+
+    PlayerOne playerOne;
+    PlayerTwo playerTwo;
+    PlayerThree playerThree;
+
+    static DriverInputs sample(frc::XboxController &playerOne, frc::XboxController &playerTwo, frc::Joystick &playerThree) {
+
+        DriverInputs inputs;
+
+        inputs.playerOne.leftX =        playerOne.GetX(frc::GenericHID::kLeftHand);
+        inputs.playerOne.leftY =        playerOne.GetY(frc::GenericHID::kLeftHand);
+        inputs.playerOne.rightX =       playerOne.GetX(frc::GenericHID::kRightHand);
+        inputs.playerOne.leftBumper =   playerOne.GetBumper(frc::GenericHID::kLeftHand);
+        inputs.playerOne.buttonA =      playerOne.GetAButton();
+        inputs.playerOne.buttonB =      playerOne.GetBButton();
+        inputs.playerOne.buttonX =      playerOne.GetXButton();
+        inputs.playerOne.buttonY =      playerOne.GetYButton();
+
+        inputs.playerTwo.leftX =                playerTwo.GetX(frc::GenericHID::kLeftHand);
+        inputs.playerTwo.leftY =                playerTwo.GetY(frc::GenericHID::kLeftHand);
+        inputs.playerTwo.rightX =               playerTwo.GetX(frc::GenericHID::kRightHand);
+        inputs.playerTwo.rightY =               playerTwo.GetY(frc::GenericHID::kRightHand);
+        inputs.playerTwo.leftTrigger =          playerTwo.GetTriggerAxis(frc::GenericHID::kLeftHand);
+        inputs.playerTwo.rightTrigger =         playerTwo.GetTriggerAxis(frc::GenericHID::kRightHand);
+        inputs.playerTwo.leftBumper =           playerTwo.GetBumper(frc::GenericHID::kLeftHand);
+        inputs.playerTwo.leftBumperPressed =    playerTwo.GetBumperPressed(frc::GenericHID::kLeftHand);
+        inputs.playerTwo.rightBumper =          playerTwo.GetBumper(frc::GenericHID::kRightHand);
+        inputs.playerTwo.rightBumperPressed =   playerTwo.GetBumperPressed(frc::GenericHID::kRightHand);
+        inputs.playerTwo.buttonA =              playerTwo.GetAButton();
+        inputs.playerTwo.buttonAPressed =       playerTwo.GetAButtonPressed();
+        inputs.playerTwo.buttonX =              playerTwo.GetXButton();
+        inputs.playerTwo.buttonY =              playerTwo.GetYButton();
+        inputs.playerTwo.buttonBack =           playerTwo.GetBackButton();
+        inputs.playerTwo.buttonStart =          playerTwo.GetStartButton();
+        inputs.playerTwo.button9 =              playerTwo.GetRawButton(9);
+        inputs.playerTwo.pov =                  playerTwo.GetPOV();
+
+        inputs.playerThree.x =          playerThree.GetX();
+        inputs.playerThree.y =          playerThree.GetY();
+        inputs.playerThree.z =          playerThree.GetZ();
+        inputs.playerThree.throttle =   playerThree.GetThrottle();
+        inputs.playerThree.button2 =    playerThree.GetRawButton(2);
+        inputs.playerThree.button3 =    playerThree.GetRawButton(3);
+        inputs.playerThree.button4 =    playerThree.GetRawButton(4);
+        inputs.playerThree.button5 =    playerThree.GetRawButton(5);
+        inputs.playerThree.button6 =    playerThree.GetRawButton(6);
+        inputs.playerThree.button7 =    playerThree.GetRawButton(7);
+        inputs.playerThree.button12 =   playerThree.GetRawButton(12);
+
+        return inputs;
+    }
+};
@@ -0,0 +1,237 @@
+/*
+class GalacticSearch
+
+Constructors
+
+    GalacticSearch(Limelight&, SensorSampler&)
+        Creates a classifier for the Galactic Search layouts, which looks
+        through the supplied Limelight as read by the supplied sampler.
+
+Public Methods
+
+    void preload()
+        Reads the recording of every path, so that the chosen one can be
+        played the moment the layout is known. Call from RobotInit.
+    void start()
+        Switches the Limelight to its Power Cell pipeline and begins
+        classifying, forgetting any earlier result. Does nothing if already
+        classifying.
+    bool update()
+        Call once per loop, after the sampler's update, while classifying
+        (from DisabledPeriodic while Galactic Search is selected, and then
+        from its auto step). Returns true once the layout is known. Keeps
+        watching after, so that a layout changed while disabled is seen.
+    void stop()
+        Returns the Limelight to its power port pipeline, and stops
+        classifying. The result is kept.
+    int getPath()
+        Returns the layout seen (Path), or kUnknown.
+    double getLatency()
+        Returns the seconds from the capture of the first of the frames
+        which decided the layout to when it was decided, which includes the
+        Limelight's own latency. The time since start() is also reported
+        to the driver station, as it includes switching pipelines.
+    const std::vector<Recording::ControllerState>& getRecording(const int&)
+        Returns the preloaded recording of the supplied path, which is
+        empty if it could not be read.
+    static std::string GetName(const int&)
+        Returns the name of the supplied path's recording, such as
+        "path-a-red".
+
+    enum Path
+        The four layouts, and kUnknown.
+
+The layout is read from the nearest Power Cell, the largest the Power Cell
+pipeline sees: red paths begin with one close by, and paths A and B place it
+to different sides. Each Limelight frame is matched to the path whose
+R_galacticSearch... signature is closest, and the layout is decided once
+R_galacticSearchFramesAgreeing distinct frames in a row agree. Frames are
+only counted once the Limelight reports running the Power Cell pipeline.
+*/
+
+#pragma once
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <frc/DriverStation.h>
+
+#include "auto/Recorder.h"
+#include "auto/Recording.h"
+#include "Limelight.h"
+#include "RobotMap.h"
+#include "SensorSampler.h"
+
+class GalacticSearch {
+
+    public:
+        enum Path {
+
+            kUnknown = -1,
+            kARed,
+            kABlue,
+            kBRed,
+            kBBlue,
+            kPaths
+        };
+
+        GalacticSearch(Limelight &refLimelight, SensorSampler &refSensors) {
+
+            m_limelight = &refLimelight;
+            m_sensors = &refSensors;
+            m_classifying = false;
+            reset();
+        }
+
+        void preload() {
+
+            for (int path = 0; path < kPaths; ++path) {
+
+                m_recordings[path].clear();
+                std::string error = Recording::Load(Recorder::GetDirectory() + GetName(path), m_recordings[path]);
+                if (!error.empty()) {
+
+                    m_recordings[path].clear();
+                    frc::DriverStation::ReportError("Galactic Search: unable to preload " + GetName(path) + ": " + error);
+                }
+            }
+        }
+
+        void start() {
+
+            if (m_classifying) {
+
+                return;
+            }
+            reset();
+            m_limelight->setPipeline(R_limelightPipelinePowerCells);
+            m_startTime = m_sensors->getFrame().time;
+            m_classifying = true;
+        }
+
+        bool update() {
+
+            if (!m_classifying || m_limelight->getPipeline() != R_limelightPipelinePowerCells) {
+
+                return m_path != kUnknown;
+            }
+            const SensorFrame &frame = m_sensors->getFrame();
+            //The sampler reads far faster than the Limelight's frame rate, so
+            //only count values which have changed as a new frame.
+            if (!frame.targetVisible || (frame.targetHorizontalOffset == m_lastTx && frame.targetArea == m_lastArea)) {
+
+                return m_path != kUnknown;
+            }
+            m_lastTx = frame.targetHorizontalOffset;
+            m_lastArea = frame.targetArea;
+
+            int path = classify(frame.targetHorizontalOffset, frame.targetArea);
+            if (path == m_candidate) {
+
+                m_agreeing++;
+            }
+            else {
+
+                m_candidate = path;
+                m_agreeing = 1;
+                m_firstCaptured = frame.time - m_limelight->getLatency();
+            }
+            if (m_agreeing < R_galacticSearchFramesAgreeing || path == m_path) {
+
+                return m_path != kUnknown;
+            }
+
+            m_path = path;
+            m_latency = frame.time - m_firstCaptured;
+            std::ostringstream message;
+            message << std::fixed << std::setprecision(3) << "Galactic Search: " << GetName(m_path) << " in " << m_latency << " seconds from capture, " << frame.time - m_startTime << " from start";
+            frc::DriverStation::ReportError(message.str());
+            return true;
+        }
+
+        void stop() {
+
+            if (m_classifying) {
+
+                m_limelight->setPipeline(R_limelightPipelinePowerPort);
+                m_classifying = false;
+            }
+        }
+
+        int getPath() {
+
+            return m_path;
+        }
+        double getLatency() {
+
+            return m_latency;
+        }
+        const std::vector<Recording::ControllerState>& getRecording(const int &path) {
+
+            return m_recordings[path];
+        }
+
+        static std::string GetName(const int &path) {
+
+            switch (path) {
+
+                case kARed: return "path-a-red";
+                case kABlue: return "path-a-blue";
+                case kBRed: return "path-b-red";
+                case kBBlue: return "path-b-blue";
+                default: return "unknown";
+            }
+        }
+
+    private:
+        static int classify(const double &tx, const double &area) {
+
+            const double signatures[kPaths][2] = {
+                {R_galacticSearchARedTx, R_galacticSearchARedArea},
+                {R_galacticSearchABlueTx, R_galacticSearchABlueArea},
+                {R_galacticSearchBRedTx, R_galacticSearchBRedArea},
+                {R_galacticSearchBBlueTx, R_galacticSearchBBlueArea}
+            };
+            int closest = kARed;
+            double closestDistance = -1;
+            for (int path = 0; path < kPaths; ++path) {
+
+                double dTx = (tx - signatures[path][0]) / R_galacticSearchTxScale;
+                double dArea = (area - signatures[path][1]) / R_galacticSearchAreaScale;
+                double distance = dTx * dTx + dArea * dArea;
+                if (closestDistance < 0 || distance < closestDistance) {
+
+                    closest = path;
+                    closestDistance = distance;
+                }
+            }
+            return closest;
+        }
+
+        void reset() {
+
+            m_path = kUnknown;
+            m_candidate = kUnknown;
+            m_agreeing = 0;
+            m_lastTx = 0;
+            m_lastArea = 0;
+            m_startTime = 0;
+            m_firstCaptured = 0;
+            m_latency = 0;
+        }
+
+        Limelight *m_limelight;
+        SensorSampler *m_sensors;
+        std::vector<Recording::ControllerState> m_recordings[kPaths];
+        bool m_classifying;
+        int m_path;
+        int m_candidate;
+        int m_agreeing;
+        double m_lastTx;
+        double m_lastArea;
+        double m_startTime;
+        double m_firstCaptured;
+        double m_latency;
+};
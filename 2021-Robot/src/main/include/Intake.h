@@ -10,26 +10,49 @@ Constructors
 Public Methods
 
     void setSpeed(const double& = 0)
-        Sets the speed of the intake motor. Defaults to 0.
+        Sets the speed of the intake motor. Defaults to 0. Positive speeds
+        take Power Cells in.
+    double getSpeed()
+        Returns the speed last set.
+    double getCurrent()
+        Returns the output current of the intake motor in amps.
 */
 
 #pragma once
 
+#include <atomic>
+
 #include "rev/CANSparkMax.h"
 
+#include "CachedOutput.h"
+
 class Intake {
 
     public:
         Intake(const int &intakeMotorCANID) {
 
-            m_intakeMotor = new rev::CANSparkMax(intakeMotorCANID, rev::CANSparkMax::MotorType::kBrushed);
+            //The current is watched for Power Cells being taken in.
+            m_intakeMotor = new CachedSparkMax(intakeMotorCANID, rev::CANSparkMax::MotorType::kBrushed, StatusFramePeriods::kCurrentSensed);
+            m_speed = 0;
         }
 
         void setSpeed(const double &speedToSet = 0) {
 
+            m_speed = speedToSet;
             m_intakeMotor->Set(speedToSet);
         }
 
+        double getSpeed() {
+
+            return m_speed.load();
+        }
+        double getCurrent() {
+
+            return m_intakeMotor->GetMotor()->GetOutputCurrent();
+        }
+
     private:
-        rev::CANSparkMax *m_intakeMotor;
+        CachedSparkMax *m_intakeMotor;
+        //Read by the ball counter on the sampler's thread.
+        std::atomic<double> m_speed;
 };
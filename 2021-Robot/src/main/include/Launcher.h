@@ -15,32 +15,46 @@ Public Methods
         Sets the speed of the launching motors. If the speed supplied
         is less than the global idling speed, sets that instead. Defaults
         to zero, which becomes a default to the idling speed.
+    double getLaunchRPM()
+        Returns the measured speed of the launching motors in RPM, as an
+        absolute value regardless of the direction of rotation.
+    double getIndexSpeed()
+        Returns the index speed last set. Positive speeds feed the flywheel.
+    double getIndexCurrent()
+        Returns the output current of the indexing motor in amps.
 */
 
 #pragma once
 
+#include <atomic>
+
 #include <rev/CANSparkMax.h>
 
+#include "CachedOutput.h"
 #include "RobotMap.h"
-#include <frc/Servo.h>
-#include <frc/Victor.h>
 
 class Launcher {
 
     public:
         Launcher(const int &indexMotorCANID, const int &launchMotorOneCANID, const int &launchMotorTwoCANID, const int &rightServoPort, const int &leftServoPort) {
 
-            indexMotor = new rev::CANSparkMax(indexMotorCANID, rev::CANSparkMax::MotorType::kBrushed);
-            launchMotorOne = new rev::CANSparkMax(launchMotorOneCANID, rev::CANSparkMax::MotorType::kBrushless);
-            launchMotorTwo = new rev::CANSparkMax(launchMotorTwoCANID, rev::CANSparkMax::MotorType::kBrushless);
-            rightServo = new frc::Servo(rightServoPort);
-            leftServo = new frc::Servo(leftServoPort);
+            //The index current is watched for Power Cells being fed, and the
+            //first launching motor's velocity is the flywheel RPM. Nothing
+            //else is read from them.
+            indexMotor = new CachedSparkMax(indexMotorCANID, rev::CANSparkMax::MotorType::kBrushed, StatusFramePeriods::kCurrentSensed);
+            launchMotorOne = new CachedSparkMax(launchMotorOneCANID, rev::CANSparkMax::MotorType::kBrushless, StatusFramePeriods::kFlywheel);
+            launchMotorTwo = new CachedSparkMax(launchMotorTwoCANID, rev::CANSparkMax::MotorType::kBrushless, StatusFramePeriods::kOpenLoop);
+            launchEncoder = new rev::CANEncoder(launchMotorOne->GetMotor()->GetEncoder());
+            rightServo = new CachedServo(rightServoPort);
+            leftServo = new CachedServo(leftServoPort);
+            indexSpeed = 0;
         }
 
         void setIndexSpeed(const double &speedToSet = 0) {
 
             //Both motors are mounted counterclockwise, so invert all numbers
             //to turn in the sensible direction.
+            indexSpeed = speedToSet;
             indexMotor->Set(-speedToSet);
         }
         void setLaunchSpeed(const double &speedToSet = 0) {
@@ -49,8 +63,21 @@ class Launcher {
             //Invert the inversion for the second motor,
             //as they are mounted on opposite sides.
             launchMotorTwo->Set(speedToSet);
+        }
+
+        double getLaunchRPM() {
+
+            //The first motor is inverted, so its velocity reads negative
+            //while launching.
+            return abs(launchEncoder->GetVelocity());
+        }
+        double getIndexSpeed() {
+
+            return indexSpeed.load();
+        }
+        double getIndexCurrent() {
 
-            
+            return indexMotor->GetMotor()->GetOutputCurrent();
         }
 
         enum SetMode {
@@ -90,9 +117,12 @@ class Launcher {
         }
 
     private:
-        rev::CANSparkMax *indexMotor;
-        rev::CANSparkMax *launchMotorOne;
-        rev::CANSparkMax *launchMotorTwo;
-        frc::Servo *rightServo;
-        frc::Servo *leftServo;
+        CachedSparkMax *indexMotor;
+        CachedSparkMax *launchMotorOne;
+        CachedSparkMax *launchMotorTwo;
+        rev::CANEncoder *launchEncoder;
+        CachedServo *rightServo;
+        CachedServo *leftServo;
+        //Read by the ball counter on the sampler's thread.
+        std::atomic<double> indexSpeed;
 };
@@ -0,0 +1,29 @@
+//LauncherCalibration: Measured launcher calibration points, sorted by target
+//area. Generated by RefitLauncherModel from 18-13-2-16-2021.csv,
+//keeping only scoring shots taken at a launch speed of 0.76378. RPM is
+//stored as a magnitude. Regenerate rather than editing by hand.
+
+#pragma once
+
+struct LauncherCalibrationPoint {
+
+    double area;
+    double rpm;
+    double servo;
+};
+
+constexpr LauncherCalibrationPoint R_launcherCalibration[] = {
+
+    {1.2605,  3754.28, 4},
+    {1.30642, 3771.43, 17},
+    {1.33437, 3777.14, 15},
+    {1.39061, 3797.14, 25.5},
+    {1.5327,  3811.43, 39},
+    {1.54002, 3542.86, 47},
+    {1.66314, 3714.28, 64},
+    {1.745,   3805.71, 48},
+    {1.93467, 3834.29, 59},
+    {2.03384, 3720,    72},
+    {2.23815, 3845.71, 96},
+    {2.28141, 3754.28, 100}
+};
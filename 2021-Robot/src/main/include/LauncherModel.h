@@ -0,0 +1,118 @@
+/*
+class LauncherModel
+
+Public Functions
+
+    LauncherModel::Solution solve(const double&)
+        Returns the hood angle and flywheel RPM for the supplied Limelight
+        target area, interpolated between the measured calibration points
+        in LauncherCalibration.h. Outside of the measured range, the nearest
+        calibration point is returned rather than extrapolating.
+
+    struct Solution
+        The servo angle (degrees, 0-180) and flywheel RPM to launch with.
+
+Interpolation is piecewise cubic Hermite with Fritsch-Carlson slopes: it
+passes through every calibration point and never overshoots between two of
+them, unlike a single high-degree polynomial fit. The slopes are computed
+at compile time, so each lookup is a binary search and one cubic.
+*/
+
+#pragma once
+
+#include <array>
+
+#include "LauncherCalibration.h"
+
+constexpr int R_launcherCalibrationCount = sizeof(R_launcherCalibration) / sizeof(R_launcherCalibration[0]);
+static_assert(R_launcherCalibrationCount >= 2, "The launcher model needs at least two calibration points");
+
+//Computes the Fritsch-Carlson (PCHIP) slope at every calibration point for
+//the supplied member (servo or rpm) with respect to area.
+constexpr std::array<double, R_launcherCalibrationCount> launcherCalibrationSlopes(double LauncherCalibrationPoint::*value) {
+
+    constexpr int count = R_launcherCalibrationCount;
+    std::array<double, count> secants {};
+    std::array<double, count> result {};
+    for (int k = 0; k < count - 1; ++k) {
+
+        secants[k] = (R_launcherCalibration[k + 1].*value - R_launcherCalibration[k].*value) / (R_launcherCalibration[k + 1].area - R_launcherCalibration[k].area);
+    }
+    result[0] = secants[0];
+    result[count - 1] = secants[count - 2];
+    for (int k = 1; k < count - 1; ++k) {
+
+        //At a local extreme (or a flat segment), the curve must be flat too,
+        //or it would overshoot the data.
+        if (secants[k - 1] * secants[k] <= 0) {
+
+            result[k] = 0;
+        }
+        else {
+
+            double hBefore = R_launcherCalibration[k].area - R_launcherCalibration[k - 1].area;
+            double hAfter = R_launcherCalibration[k + 1].area - R_launcherCalibration[k].area;
+            result[k] = 3 * (hBefore + hAfter) / ((2 * hAfter + hBefore) / secants[k - 1] + (hAfter + 2 * hBefore) / secants[k]);
+        }
+    }
+    return result;
+}
+
+class LauncherModel {
+
+    public:
+        struct Solution {
+
+            double servo;
+            double rpm;
+        };
+
+        static constexpr Solution solve(const double &area) {
+
+            if (area <= R_launcherCalibration[0].area) {
+
+                return {R_launcherCalibration[0].servo, R_launcherCalibration[0].rpm};
+            }
+            if (area >= R_launcherCalibration[kCount - 1].area) {
+
+                return {R_launcherCalibration[kCount - 1].servo, R_launcherCalibration[kCount - 1].rpm};
+            }
+            //Find the segment [low, low + 1] which contains the area...
+            int low = 0;
+            int high = kCount - 1;
+            while (high - low > 1) {
+
+                int middle = (low + high) / 2;
+                if (R_launcherCalibration[middle].area <= area) {
+
+                    low = middle;
+                }
+                else {
+
+                    high = middle;
+                }
+            }
+            //And evaluate both curves on it.
+            double h = R_launcherCalibration[high].area - R_launcherCalibration[low].area;
+            double t = (area - R_launcherCalibration[low].area) / h;
+            double servo = hermite(t, h, R_launcherCalibration[low].servo, R_launcherCalibration[high].servo, kServoSlopes[low], kServoSlopes[high]);
+            double rpm = hermite(t, h, R_launcherCalibration[low].rpm, R_launcherCalibration[high].rpm, kRPMSlopes[low], kRPMSlopes[high]);
+            //Interpolation never leaves the range of the data, but the data
+            //itself could, so keep the servo within its travel.
+            servo = servo < 0 ? 0 : (servo > 180 ? 180 : servo);
+            return {servo, rpm};
+        }
+
+    private:
+        static constexpr int kCount = R_launcherCalibrationCount;
+
+        static constexpr double hermite(const double t, const double h, const double y0, const double y1, const double m0, const double m1) {
+
+            double t2 = t * t;
+            double t3 = t2 * t;
+            return (2 * t3 - 3 * t2 + 1) * y0 + (t3 - 2 * t2 + t) * h * m0 + (-2 * t3 + 3 * t2) * y1 + (t3 - t2) * h * m1;
+        }
+
+        static constexpr std::array<double, kCount> kServoSlopes = launcherCalibrationSlopes(&LauncherCalibrationPoint::servo);
+        static constexpr std::array<double, kCount> kRPMSlopes = launcherCalibrationSlopes(&LauncherCalibrationPoint::rpm);
+};
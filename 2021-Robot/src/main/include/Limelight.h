@@ -17,11 +17,27 @@ Public Methods
     bool getTarget()
         Returns true if there is a target in-sight, false otherwise.
     All return 0 in event of a null target.
+    bool isWithinHorizontalTolerance(const double&)
+        Returns true if the supplied horizontal offset (tx by default) is
+        close enough to zero to be considered centered.
+    double CalculateLimelightLockSpeed(const double&)
+        Returns the rotational speed which turns Zion toward the supplied
+        horizontal offset (tx by default), or a full-speed search if there
+        is no target in sight.
     void setProcessing(const bool& = true)
         Turns on or off the vision processing for using the Limelight
         as a camera. Defaults to on.
     void setLime(const bool& = true)
         Turns the Limelight LEDs on or off. Defaults to on.
+    void setPipeline(const int&)
+        Switches to the supplied pipeline (R_limelightPipeline...).
+    int getPipeline()
+        Returns the pipeline the Limelight is actually running, which lags
+        setPipeline by a frame or so.
+    double getLatency()
+        Returns the seconds from the capture of the latest frame to its
+        results: the pipeline's latency (tl) plus the Limelight's 11 ms of
+        capture latency.
 */
 
 #pragma once
@@ -29,6 +45,8 @@ Public Methods
 #include <networktables/NetworkTable.h>
 #include <networktables/NetworkTableInstance.h>
 
+#include "SpeedCurve.h"
+
 class Limelight {
 
     public:
@@ -55,7 +73,11 @@ class Limelight {
         }
         bool isWithinHorizontalTolerance() {
 
-            return abs(getHorizontalOffset()) < R_zionAutoToleranceHorizontalOffset;
+            return isWithinHorizontalTolerance(getHorizontalOffset());
+        }
+        bool isWithinHorizontalTolerance(const double &offset) {
+
+            return abs(offset) < R_zionAutoToleranceHorizontalOffset;
         }
 
         void setProcessing(const bool &toSet = true) {
@@ -68,12 +90,30 @@ class Limelight {
             //According to doc, 3 is on, 1 is off, and 2 is blink.
             table->PutNumber("ledMode", toSet ? 3 : 1);
         }
+        void setPipeline(const int &pipeline) {
+
+            table->PutNumber("pipeline", pipeline);
+        }
+        int getPipeline() {
+
+            return (int)table->GetNumber("getpipe", -1);
+        }
+        double getLatency() {
+
+            return (table->GetNumber("tl", 0) + 11) / 1000;
+        }
 
         //Almost exactly the same function as
         //SwerveModule::calculateAssumePositionSpeed, except with constants for
         //limelight lock
         double CalculateLimelightLockSpeed() {
 
+            return CalculateLimelightLockSpeed(getHorizontalOffset());
+        }
+        //Locks on to an offset other than tx, such as one which leads the
+        //target while moving.
+        double CalculateLimelightLockSpeed(const double &offset) {
+
             //This if block is for driving in limelight lock mode.  This means that no
             //matter which way we are driving, we will always be pointed at the goal.
             //Turn on the limelight so that we can check if a target is found.
@@ -83,30 +123,8 @@ class Limelight {
             //Check if we are looking at a valid target...
             if (getTarget()) {
 
-                double howFarRemainingInTravelInDegrees = getHorizontalOffset();
                 //Update our rotational speed so that we turn towards the goal.
-                //Begin initally with a double calculated with the simplex function with a horizontal stretch of factor two...
-                double toReturn = ((1) / (1 + exp((-1 * (0.5 * abs(0.5 * howFarRemainingInTravelInDegrees))) + 5)));
-                //If we satisfy conditions for the first linear piecewise, take that speed instead...
-                if (abs(howFarRemainingInTravelInDegrees) < R_swerveTrainLimelightLockPositionSpeedCalculatonFirstEndBehaviorAt) {
-
-                    toReturn = R_swerveTrainLimelightLockPositionSpeedCalculatonFirstEndBehaviorSpeed;
-                }
-                //Do the same for the second...
-                if (abs(howFarRemainingInTravelInDegrees) < R_swerveTrainLimelightLockPositionSpeedCalculatonSecondEndBehaviorAt) {
-
-                    toReturn = R_swerveTrainLimelightLockPositionSpeedCalculatonSecondEndBehaviorSpeed;
-                }
-                //And if we needed to travel negatively to get where we need to be, make the final speed negative...
-                if (abs(howFarRemainingInTravelInDegrees) < R_zionAutoToleranceHorizontalOffset) {
-
-                    toReturn = 0;
-                }
-                if (howFarRemainingInTravelInDegrees < 0) {
-
-                    toReturn = -toReturn;
-                }
-                return toReturn;
+                return R_speedCurveLimelightLock.speed(offset);
             }
             else {
 
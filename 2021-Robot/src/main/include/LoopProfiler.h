@@ -0,0 +1,261 @@
+/*
+class LoopProfiler
+
+Constructors
+
+    LoopProfiler(DashboardPublisher&)
+        Creates a profiler with empty histograms, which publishes through
+        the supplied publisher.
+
+Public Methods
+
+    void endLoop()
+        Call at the very end of every loop (the end of RobotPeriodic, which
+        runs after the mode's periodic function). Adds the loop to the
+        histograms, and if it ran longer than R_profilerOverrunTime, keeps
+        its trace. Every R_profilerPublishPeriod, publishes to the
+        SmartDashboard:
+
+        Profiler::<Phase>        p50/p99/max in milliseconds of each phase
+                                 (Input, Vision, Drive, Mechanism, Auto,
+                                 Telemetry), and of the whole Loop.
+        Profiler::Overruns       How many loops have overrun.
+        Profiler::LastOverrun    The trace of the last overrun: its length,
+                                 then the start and length of every phase
+                                 in it, in milliseconds.
+
+        The trace of an overrun is also reported to the driver station, at
+        most once per R_profilerPublishPeriod.
+    void reset()
+        Empties the histograms, such as when a new mode begins.
+
+class LoopProfiler::Scope
+
+    Scope(LoopProfiler&, const Phase&)
+        Starts timing the supplied phase. Timing stops when the scope ends.
+    void next(const Phase&)
+        Stops timing the current phase and starts timing the supplied one,
+        so that consecutive phases of a long function need no extra blocks.
+
+Times come from the monotonic clock. Histograms have R_profilerBuckets
+buckets of R_profilerBucketMicroseconds each (and one for anything longer),
+so percentiles are rounded up to a bucket; maximums are exact.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <frc/DriverStation.h>
+
+#include "DashboardPublisher.h"
+#include "RobotMap.h"
+
+class LoopProfiler {
+
+    public:
+        enum Phase {
+
+            kInput,
+            kVision,
+            kDrive,
+            kMechanism,
+            kAuto,
+            kTelemetry,
+            kPhases
+        };
+
+        class Scope {
+
+            public:
+                Scope(LoopProfiler &profiler, const Phase &phase) {
+
+                    m_profiler = &profiler;
+                    m_phase = phase;
+                    m_start = profiler.now();
+                }
+                ~Scope() {
+
+                    m_profiler->add(m_phase, m_start, m_profiler->now());
+                }
+
+                void next(const Phase &phase) {
+
+                    int64_t now = m_profiler->now();
+                    m_profiler->add(m_phase, m_start, now);
+                    m_phase = phase;
+                    m_start = now;
+                }
+
+            private:
+                LoopProfiler *m_profiler;
+                Phase m_phase;
+                int64_t m_start;
+        };
+
+        LoopProfiler(DashboardPublisher &publisher) : m_overrunsOut(publisher, "Profiler::Overruns", R_profilerPublishPeriod), m_lastOverrunOut(publisher, "Profiler::LastOverrun", R_profilerPublishPeriod) {
+
+            m_origin = std::chrono::steady_clock::now();
+            for (int phase = 0; phase <= kPhases; ++phase) {
+
+                m_histograms.push_back(Histogram());
+                m_statsOut.push_back(DashboardString(publisher, "Profiler::" + std::string(kNames[phase]), R_profilerPublishPeriod));
+            }
+            m_events = 0;
+            m_loopStart = -1;
+            m_overruns = 0;
+            m_lastPublish = 0;
+            m_lastReport = -R_profilerPublishPeriod * 1e6;
+        }
+
+        void endLoop() {
+
+            int64_t end = now();
+            if (m_loopStart >= 0) {
+
+                m_histograms[kPhases].add(end - m_loopStart);
+                if (end - m_loopStart > R_profilerOverrunTime * 1e6) {
+
+                    m_overruns++;
+                    m_lastOverrun = trace(end);
+                    if (end - m_lastReport >= R_profilerPublishPeriod * 1e6) {
+
+                        frc::DriverStation::ReportError("Loop overrun: " + m_lastOverrun);
+                        m_lastReport = end;
+                    }
+                }
+            }
+            m_events = 0;
+            m_loopStart = -1;
+
+            if (end - m_lastPublish >= R_profilerPublishPeriod * 1e6) {
+
+                publish();
+                m_lastPublish = end;
+            }
+        }
+
+        void reset() {
+
+            for (Histogram &histogram : m_histograms) {
+
+                histogram = Histogram();
+            }
+        }
+
+    private:
+        //Counts of durations in microseconds.
+        struct Histogram {
+
+            Histogram() : counts(R_profilerBuckets + 1, 0) {
+
+                total = 0;
+                max = 0;
+            }
+
+            void add(const int64_t &duration) {
+
+                int64_t bucket = duration / R_profilerBucketMicroseconds;
+                counts[bucket < R_profilerBuckets ? bucket : R_profilerBuckets]++;
+                total++;
+                max = duration > max ? duration : max;
+            }
+
+            //The upper edge of the bucket holding the given fraction of
+            //durations.
+            int64_t percentile(const double &fraction) const {
+
+                uint32_t target = (uint32_t)(fraction * total + .5);
+                uint32_t seen = 0;
+                for (int bucket = 0; bucket < R_profilerBuckets; ++bucket) {
+
+                    seen += counts[bucket];
+                    if (seen >= target) {
+
+                        int64_t edge = (int64_t)(bucket + 1) * R_profilerBucketMicroseconds;
+                        return edge < max ? edge : max;
+                    }
+                }
+                return max;
+            }
+
+            std::vector<uint32_t> counts;
+            uint32_t total;
+            int64_t max;
+        };
+
+        struct Event {
+
+            Phase phase;
+            int64_t start;
+            int64_t end;
+        };
+
+        int64_t now() const {
+
+            return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_origin).count();
+        }
+
+        void add(const Phase &phase, const int64_t &start, const int64_t &end) {
+
+            m_histograms[phase].add(end - start);
+            if (m_loopStart < 0 || start < m_loopStart) {
+
+                m_loopStart = start;
+            }
+            if (m_events < kMaxEvents) {
+
+                m_trace[m_events] = {phase, start, end};
+                m_events++;
+            }
+        }
+
+        std::string trace(const int64_t &end) const {
+
+            std::ostringstream out;
+            out << std::fixed << std::setprecision(2) << (end - m_loopStart) / 1e3 << "ms:";
+            for (int event = 0; event < m_events; ++event) {
+
+                const Event &e = m_trace[event];
+                out << ' ' << kNames[e.phase] << '@' << (e.start - m_loopStart) / 1e3 << '+' << (e.end - e.start) / 1e3;
+            }
+            return out.str();
+        }
+
+        void publish() {
+
+            for (int phase = 0; phase <= kPhases; ++phase) {
+
+                const Histogram &histogram = m_histograms[phase];
+                std::ostringstream stats;
+                stats << std::fixed << std::setprecision(2) << "p50 " << histogram.percentile(.5) / 1e3 << " p99 " << histogram.percentile(.99) / 1e3 << " max " << histogram.max / 1e3;
+                m_statsOut[phase].set(stats.str());
+            }
+            m_overrunsOut.set(m_overruns);
+            m_lastOverrunOut.set(m_lastOverrun);
+        }
+
+        //The names of the phases, then of the whole loop.
+        static constexpr const char *kNames[kPhases + 1] = {"Input", "Vision", "Drive", "Mechanism", "Auto", "Telemetry", "Loop"};
+        static const int kMaxEvents = 32;
+
+        std::chrono::steady_clock::time_point m_origin;
+        //One per phase, then the whole loop.
+        std::vector<Histogram> m_histograms;
+        std::vector<DashboardString> m_statsOut;
+        Event m_trace[kMaxEvents];
+        int m_events;
+        int64_t m_loopStart;
+        int m_overruns;
+        std::string m_lastOverrun;
+        int64_t m_lastPublish;
+        int64_t m_lastReport;
+        DashboardNumber m_overrunsOut;
+        DashboardString m_lastOverrunOut;
+};
@@ -4,7 +4,8 @@ class NavX
 Constructors
 
     NavX(const int&)
-        Creates a NavX on the specified interface (kUSB, kMXP)
+        Creates a NavX on the specified interface (kUSB, kMXP), updating
+        R_navXUpdateRate times per second, and keeps every update.
 
 Public Methods
 
@@ -13,42 +14,69 @@ Public Methods
     double getYawFull()
         Returns the yaw value from 0-360.
         Rolls over at extremes; used with the standard unit circle.
+    bool getLatestSample(NavXSample&)
+    bool getSampleAt(const double&, NavXSample&)
+        Set the supplied sample to the newest update, or to the NavX's state
+        at the supplied FPGA time in seconds, as NavXHistory::getLatest and
+        getAt. Return false if there is none (as when simulated).
+    double getRoll()
+        Returns the roll value, -180 to 180.
     double getAngle()
         Returns the angle value (-infinity to infinity, beginning at 0).
     double getAbsoluteAngle()
         Returns the absolute value of the angle value.
     void resetYaw()
-        Sets the yaw value to zero.
+        Sets the yaw value to zero, and forgets every update before.
     void resetAll()
         Resets all NavX return values and calibrates the sensor.
 
     enum ConnectionType
         Used with the constructor to specify which interface to construct on.
+
+Each update is taken as the NavX sends it, on its own thread, and kept with
+the time the NavX took it. That time is on the NavX's clock, which is mapped
+onto the FPGA's by the smallest difference seen between the two (that is,
+the update which arrived soonest after it was taken), so that updates line
+up with everything else timed by the FPGA. The yaw rate is the change
+between successive updates.
 */
 
 #pragma once
 
 #include <math.h>
 
+#include <atomic>
+
+#include <frc/Timer.h>
+
 #include "AHRS.h"
+#include "NavXHistory.h"
+#include "RobotMap.h"
 
-class NavX {
+class NavX : public ITimestampedDataSubscriber {
 
     public:
         NavX(const int &connectionType) {
 
             if (connectionType == kUSB) {
 
-                navX = new AHRS(frc::SPI::kOnboardCS0);
+                navX = new AHRS(frc::SPI::kOnboardCS0, (uint8_t)R_navXUpdateRate);
             }
             else if (connectionType == kMXP) {
 
-                navX = new AHRS(frc::SPI::kMXP);
+                navX = new AHRS(frc::SPI::kMXP, (uint8_t)R_navXUpdateRate);
             }
             else {
 
-                navX = new AHRS(frc::SPI::kMXP);
+                navX = new AHRS(frc::SPI::kMXP, (uint8_t)R_navXUpdateRate);
             }
+            m_resets = 0;
+            m_lastResets = 0;
+            m_synced = false;
+            m_clockOffset = 0;
+            m_lastSensorTime = 0;
+            m_hasLast = false;
+            navX->RegisterCallback(this, nullptr);
         }
 
         double getYaw() {
@@ -57,15 +85,30 @@ class NavX {
         }
         double getYawFull(){
 
-            if (getYaw() < 0) {
+            //Read once, so both branches see the same instant.
+            double yaw = getYaw();
+            if (yaw < 0) {
 
-                return getYaw() + 360;
+                return yaw + 360;
             }
             else {
 
-                return getYaw();
+                return yaw;
             }
         }
+        double getRoll() {
+
+            return navX->GetRoll();
+        }
+        bool getLatestSample(NavXSample &sample) {
+
+            return m_history.getLatest(sample);
+        }
+        bool getSampleAt(const double &time, NavXSample &sample) {
+
+            return m_history.getAt(time, sample);
+        }
+
         double getAngle() {
 
             return navX->GetAngle();
@@ -78,6 +121,8 @@ class NavX {
         void resetYaw() {
 
             navX->ZeroYaw();
+            m_history.clear();
+            m_resets++;
         }
         void resetAll() {
 
@@ -90,6 +135,62 @@ class NavX {
             kMXP = 4
         };
 
+        //Called on the NavX's thread with each update.
+        void timestampedDataReceived(long systemTimestamp, long sensorTimestamp, AHRSProtocol::AHRSUpdateBase &data, void *context) override {
+
+            double now = frc::Timer::GetFPGATimestamp();
+            double sensorTime = sensorTimestamp / 1000.0;
+            double offset = now - sensorTime;
+            if (!m_synced) {
+
+                m_clockOffset = offset;
+                m_synced = true;
+            }
+            else {
+
+                m_clockOffset += (sensorTime - m_lastSensorTime) * R_navXClockSlew;
+                if (offset < m_clockOffset) {
+
+                    m_clockOffset = offset;
+                }
+            }
+            m_lastSensorTime = sensorTime;
+
+            NavXSample sample;
+            sample.time = sensorTime + m_clockOffset;
+            //The update carries the raw yaw, where the AHRS has already
+            //taken it in with any zeroing applied.
+            sample.yaw = navX->GetYaw();
+            int resets = m_resets.load();
+            if (!m_hasLast || resets != m_lastResets || sample.time <= m_last.time) {
+
+                sample.angle = sample.yaw;
+                sample.yawRate = 0;
+            }
+            else {
+
+                sample.angle = m_last.angle + remainder(sample.yaw - m_last.yaw, 360);
+                sample.yawRate = (sample.angle - m_last.angle) / (sample.time - m_last.time);
+            }
+            sample.accelX = data.linear_accel_x;
+            sample.accelY = data.linear_accel_y;
+            sample.accelZ = data.linear_accel_z;
+            m_history.add(sample);
+            m_last = sample;
+            m_lastResets = resets;
+            m_hasLast = true;
+        }
+
     private:
         AHRS *navX;
+        NavXHistory m_history;
+        std::atomic<int> m_resets;
+
+        //Only the NavX's thread uses these.
+        int m_lastResets;
+        bool m_synced;
+        double m_clockOffset;
+        double m_lastSensorTime;
+        bool m_hasLast;
+        NavXSample m_last;
 };
@@ -0,0 +1,159 @@
+/*
+struct NavXSample
+
+One update from the NavX.
+
+    double time
+        The FPGA time in seconds at which the NavX took the sample.
+    double yaw
+        The yaw, -180 to 180, clockwise.
+    double angle
+        The yaw without rolling over at 180, for interpolating across it.
+    double yawRate
+        How fast the yaw is changing, in degrees per second clockwise.
+    double accelX
+    double accelY
+    double accelZ
+        The linear acceleration in g, gravity removed, in the NavX's axes.
+
+class NavXHistory
+
+Constructors
+
+    NavXHistory()
+        Creates an empty history of the last R_navXHistorySize samples.
+
+Public Methods
+
+    void add(const NavXSample&)
+        Keeps the supplied sample, dropping the oldest if full. Samples must
+        be added in order of time.
+    void clear()
+        Forgets every sample, such as when the yaw is zeroed.
+    bool getLatest(NavXSample&)
+        Sets the supplied sample to the newest kept, and returns false
+        (leaving it alone) if there are none.
+    bool getAt(const double&, NavXSample&)
+        Sets the supplied sample to the NavX's state at the supplied FPGA
+        time in seconds, interpolated between the samples either side. A
+        time after the newest sample gets the newest. Returns false
+        (leaving it alone) if there are no samples that old.
+
+The NavX thread adds while the loop reads, so every method takes a lock,
+held only to copy a sample or two.
+*/
+
+#pragma once
+
+#include <math.h>
+
+#include <mutex>
+
+#include "RobotMap.h"
+
+struct NavXSample {
+
+    double time;
+    double yaw;
+    double angle;
+    double yawRate;
+    double accelX;
+    double accelY;
+    double accelZ;
+};
+
+class NavXHistory {
+
+    public:
+        NavXHistory() {
+
+            m_next = 0;
+            m_size = 0;
+        }
+
+        void add(const NavXSample &sample) {
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_samples[m_next] = sample;
+            m_next = (m_next + 1) % R_navXHistorySize;
+            if (m_size < R_navXHistorySize) {
+
+                m_size++;
+            }
+        }
+
+        void clear() {
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_size = 0;
+        }
+
+        bool getLatest(NavXSample &sample) {
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_size == 0) {
+
+                return false;
+            }
+            sample = get(m_size - 1);
+            return true;
+        }
+
+        bool getAt(const double &time, NavXSample &sample) {
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_size == 0 || time < get(0).time) {
+
+                return false;
+            }
+            if (time >= get(m_size - 1).time) {
+
+                sample = get(m_size - 1);
+                return true;
+            }
+            //Find the first sample at or after the time. There is one, and
+            //one before it.
+            int low = 0;
+            int high = m_size - 1;
+            while (low < high) {
+
+                int middle = (low + high) / 2;
+                if (get(middle).time < time) {
+
+                    low = middle + 1;
+                }
+                else {
+
+                    high = middle;
+                }
+            }
+            const NavXSample &after = get(low);
+            if (low == 0 || after.time == time) {
+
+                sample = after;
+                return true;
+            }
+            const NavXSample &before = get(low - 1);
+            double fraction = (time - before.time) / (after.time - before.time);
+            sample.time = time;
+            sample.angle = before.angle + (after.angle - before.angle) * fraction;
+            sample.yaw = remainder(sample.angle, 360);
+            sample.yawRate = before.yawRate + (after.yawRate - before.yawRate) * fraction;
+            sample.accelX = before.accelX + (after.accelX - before.accelX) * fraction;
+            sample.accelY = before.accelY + (after.accelY - before.accelY) * fraction;
+            sample.accelZ = before.accelZ + (after.accelZ - before.accelZ) * fraction;
+            return true;
+        }
+
+    private:
+        //Indexed from the oldest kept.
+        const NavXSample& get(const int &index) {
+
+            return m_samples[(m_next - m_size + index + R_navXHistorySize) % R_navXHistorySize];
+        }
+
+        std::mutex m_mutex;
+        NavXSample m_samples[R_navXHistorySize];
+        int m_next;
+        int m_size;
+};
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <stdint.h>
+
 #include <string>
 
 #include <frc/smartdashboard/SendableChooser.h>
 #include <frc/TimedRobot.h>
 
+#include "DashboardChooser.h"
+#include "DashboardTunable.h"
+
 class Robot : public frc::TimedRobot {
 
     public:
@@ -15,11 +20,24 @@ class Robot : public frc::TimedRobot {
         void TeleopInit() override;
         void TeleopPeriodic() override;
         void DisabledPeriodic() override;
+        void SimulationInit() override;
+        void SimulationPeriodic() override;
+
+        //True once the selected autonomous has finished every step.
+        bool isAutoComplete();
 
     private:
         frc::SendableChooser<std::string> *m_chooserAuto;
         frc::SendableChooser<std::string> *m_chooserController;
         std::string m_chooserAutoSelected;
+        bool m_autoComplete;
+        DashboardChooser *m_selectionAuto;
+        DashboardChooser *m_selectionController;
+        bool m_useXboxController;
+
+        DashboardTunable *m_tunableSpeedIndex;
+        DashboardTunable *m_tunableSpeedLauncher;
+        DashboardTunable *m_tunableServoAngle;
 
         //These are used such that each speed is only set once for P2.
         //Prevents weird assignment bugs with motor speeds.
@@ -31,6 +49,10 @@ class Robot : public frc::TimedRobot {
         double m_speedLauncherIndex;
         double m_speedLauncherLaunch;
         double m_servoPosition;
-        double m_zeroButtonWasPressed;
+        uint32_t m_swerveUnlockPresses;
+        bool m_calibrationShotWasMarked;
+        //The last nonzero launch speed, which is what a shot marked after
+        //the flywheel is released was launched with.
+        double m_calibrationLaunchSpeed;
         double m_swerveBrake;
 };
@@ -20,6 +20,12 @@ const int R_PWMPortLeftServo             = 5;
 /*_____RoboRIO DIO Pin Declarations_____*/
 const int R_DIOPortSwitchClimberBottom = 0;
 const int R_DIOPortSwitchSwerveUnlock  = 1;
+//This is how long in seconds a switch must have been quiet for a press to
+//count, so that contact bounce is not counted as more presses.
+const double R_switchDebounceTime = .02;
+//Set false to drive the climber down past its bottom switch, as when the
+//switch is unplugged.
+const bool R_climberBottomLimitEnabled = true;
 /*___End RoboRIO DIO Pin Declarations___*/
 
 /*_____RoboRIO CAN Bus ID Declarations_____*/
@@ -40,6 +46,14 @@ const int R_CANIDMotorLauncherLaunchTwo = 12;
 
 const int R_CANIDMotorClimberForward = 14;
 const int R_CANIDMotorClimberRear = 13;
+//This is the longest in seconds an unchanged setpoint goes without being
+//resent to its motor controller or servo.
+const double R_outputKeepAlivePeriod = .25;
+//This is how often in seconds the CAN bus summary is published.
+const double R_canTelemetryPublishPeriod = 1.0;
+//And this is how long in seconds a loop can take before it is counted as a
+//spike (the nominal loop is .02).
+const double R_canTelemetryLoopSpikeTime = .03;
 /*___End RoboRIO CAN Bus ID Declarations___*/
 
 /*_____Controller Settings_____*/
@@ -68,6 +82,88 @@ const double R_executionCapIntake = .75;
 const double R_launcherDefaultSpeedIndex = .65;
 //And this the default launcher launch speed, for both distances and idle.
 const double R_launcherDefaultSpeed = .76378;
+//This is how long in seconds a synchronous SetLauncherRPM gives the flywheel
+//to spool up before moving on.
+const double R_launcherSpoolUpTime = 7;
+//This is the most Power Cells the magazine can hold at once.
+const int R_launcherMagazineCapacity = 5;
+//This is how close in RPM the flywheel must be to its settled speed before
+//the next Power Cell is fed to it.
+const double R_launcherShootRecoveredToleranceRPM = 100;
+//And this is how far the flywheel must drop below its settled speed for a
+//Power Cell to be considered launched.
+const double R_launcherShootDipRPM = 250;
+//This is the index motor current in amps above which a Power Cell is being
+//pushed into the flywheel. Below it, the index is running unloaded.
+const double R_launcherShootIndexLoadedCurrent = 4.0;
+//This is how long in seconds the index may run unloaded before the magazine
+//is considered empty.
+const double R_launcherShootEmptyTime = .35;
+//This is how long in seconds the index may feed without seeing a launch before
+//the magazine is considered empty (or jammed).
+const double R_launcherShootFeedTimeout = 1.5;
+//This is how long in seconds to wait for the flywheel to recover before
+//accepting its current speed as the new settled speed.
+const double R_launcherShootRecoveryTimeout = 1.0;
+//This is how many Power Cells are loaded before a match.
+const int R_ballCounterPreloaded = 3;
+//The ball counter follows each motor's unloaded current, moving this
+//fraction of the way to each sample. A Power Cell is counted when the
+//current stays this many amps above it (intake, then index) for this many
+//seconds. Spikes this many seconds after a motor starts are its start-up.
+const double R_ballCounterBaselineRate = .05;
+const double R_ballCounterIntakeSpikeCurrent = 6.0;
+const double R_ballCounterIndexSpikeCurrent = 5.0;
+const double R_ballCounterSpikeTime = .02;
+const double R_ballCounterStartupTime = .25;
+
+//This is where launcher calibration shots are appended when marked from P2.
+const std::string R_launcherCalibrationLogPath = "/u/launcher-calibration.csv";
+
+//This is the horizontal speed in inches per second a Power Cell leaves the
+//launcher with for each flywheel RPM. Estimated; refine by timing shots.
+const double R_launcherBallHorizontalSpeedPerRPM = .075;
+//This is how many times the time of flight is re-estimated when leading a
+//target while moving. Each pass converges on the aim point.
+const int R_launcherLeadIterations = 3;
+//This is the most the launch speed is scaled up or down by when leading a
+//target past what the hood can reach.
+const double R_launcherLeadMaxScale = 1.25;
+
+//These describe where the Limelight sits and what it looks at, in inches and
+//degrees, for finding the distance to the target from its vertical offset.
+const double R_limelightMountHeight = 21.0;
+const double R_limelightMountAngle = 25.0;
+const double R_limelightTargetHeight = 98.25;
+//These are the Limelight's pipelines for the power port and for Power Cells.
+const int R_limelightPipelinePowerPort = 0;
+const int R_limelightPipelinePowerCells = 1;
+
+//These are where the nearest Power Cell appears to the Power Cell pipeline
+//(tx in degrees, ta in percent) from the start of each Galactic Search path.
+//Measure them on the field; a layout is taken to be the one whose nearest
+//Power Cell it is closest to, with tx and ta weighed in units of the scales.
+const double R_galacticSearchARedTx = 0.0;
+const double R_galacticSearchARedArea = 2.4;
+const double R_galacticSearchABlueTx = 14.0;
+const double R_galacticSearchABlueArea = .6;
+const double R_galacticSearchBRedTx = -11.0;
+const double R_galacticSearchBRedArea = 1.8;
+const double R_galacticSearchBBlueTx = 8.0;
+const double R_galacticSearchBBlueArea = .7;
+const double R_galacticSearchTxScale = 4.0;
+const double R_galacticSearchAreaScale = .4;
+//This is how many distinct Limelight frames in a row must agree on a layout,
+//and how long in seconds into autonomous to keep looking before giving up.
+const int R_galacticSearchFramesAgreeing = 2;
+const double R_galacticSearchTimeout = 1.0;
+
+//This is how much of each new chassis velocity measurement is taken into the
+//running estimate, from 0 (ignored) to 1 (no filtering).
+const double R_zionVelocityFilterGain = .5;
+//This is the distance from the center of Zion's drivetrain to each module in
+//inches.
+const double R_zionModuleRadius = 14.5;
 
 //This is the speed for automatic lateral movement in autonomous.
 const double R_zionAutoMovementSpeedLateral = .35;
@@ -98,25 +194,107 @@ const double R_angleFromCenterToFrontRightWheel = 315.;
 const double R_angleFromCenterToRearLeftWheel = 135.;
 const double R_angleFromCenterToRearRightWheel = 225.;
 
-//These contants are used for the functions which provide assuming a position.
-//See those functions for further detail.
-const double R_swerveTrainAssumePositionTolerance = .25;
-const double R_swerveTrainAssumePositionSpeedCalculationFirstEndBehaviorAt = 3.5;
-const double R_swerveTrainAssumePositionSpeedCalculationFirstEndBehaviorSpeed = .2;
-const double R_swerveTrainAssumePositionSpeedCalculationSecondEndBehaviorAt = 1;
-const double R_swerveTrainAssumePositionSpeedCalculationSecondEndBehaviorSpeed = .02;
-
-const double R_swerveTrainLimelightLockTolerance = 1;
-const double R_swerveTrainLimelightLockPositionSpeedCalculatonFirstEndBehaviorAt = 5.0;
-const double R_swerveTrainLimelightLockPositionSpeedCalculatonFirstEndBehaviorSpeed = .05;
-const double R_swerveTrainLimelightLockPositionSpeedCalculatonSecondEndBehaviorAt = 2.5;
-const double R_swerveTrainLimelightLockPositionSpeedCalculatonSecondEndBehaviorSpeed = .025;
-
-const double R_swerveTrainHoldAngleTolerance = 1.0;
-const double R_swerveTrainHoldAngleSpeedCalculatonFirstEndBehaviorAt = 10.0;
-const double R_swerveTrainHoldAngleSpeedCalculatonFirstEndBehaviorSpeed = .075;
-const double R_swerveTrainHoldAngleSpeedCalculatonSecondEndBehaviorAt = 5.0;
-const double R_swerveTrainHoldAngleSpeedCalculatonSecondEndBehaviorSpeed = .075;
+//The constants for the speed curves used to assume a position, lock on to
+//the Limelight's target, and hold an angle are in SpeedCurveConstants.h,
+//which TuneSpeedCurves generates. See SpeedCurve.h for how they are used.
+#include "SpeedCurveConstants.h"
 
 const double R_circumfrenceWheel = 4 * M_PI;
-/*___End Global Robot Variable Settings___*/
\ No newline at end of file
+
+//This is how many records the telemetry buffer holds between writes (a power
+//of two), and how often in seconds it is written out.
+const unsigned int R_telemetryBufferRecords = 16384;
+const double R_telemetryFlushPeriod = .1;
+//These are the size in bytes at which a telemetry log file is closed and the
+//next begun, how many of a session's files are kept, and how many sessions
+//(including the current one) are kept.
+const long R_telemetryFileBytes = 8 * 1024 * 1024;
+const int R_telemetryFilesKept = 16;
+const int R_telemetrySessionsKept = 4;
+//This is how often in seconds changed values are written to the
+//SmartDashboard, and the period of values only there for debugging.
+const double R_dashboardFlushPeriod = .1;
+const double R_dashboardDebugPeriod = .5;
+//The loop profiler's histograms have this many buckets of this many
+//microseconds, and it publishes every this many seconds. A loop longer than
+//this many seconds (TimedRobot's period) has its trace kept as an overrun.
+const int R_profilerBuckets = 1024;
+const int R_profilerBucketMicroseconds = 20;
+const double R_profilerPublishPeriod = 1.0;
+const double R_profilerOverrunTime = .02;
+//The automated climb first lifts at this speed for this many seconds with the
+//ratchet unlocked, so that the pawl comes free. It then raises at this speed
+//until either climb motor draws at least this many amps for this many
+//seconds, or for at most this many seconds.
+const double R_climbUnlockSpeed = .2;
+const double R_climbUnlockTime = .25;
+const double R_climbRaiseSpeed = 1.0;
+const double R_climbStallCurrent = 40;
+const double R_climbStallTime = .2;
+const double R_climbRaiseTimeout = 6.0;
+//Then, with the ratchet locked, it translates along the bar at this speed
+//per degree of roll (negative if translating positive rolls it negative),
+//at most this fast, until the roll has been within this many degrees for
+//this many seconds, or for at most this many seconds.
+const double R_climbBalanceGain = .04;
+const double R_climbBalanceMaxSpeed = .5;
+const double R_climbBalanceTolerance = 2.0;
+const double R_climbBalanceSettleTime = .5;
+const double R_climbBalanceTimeout = 8.0;
+//The NavX sends this many updates per second (its most over SPI), and the
+//last this many are kept to look back through. Its clock is mapped onto the
+//FPGA's by the smallest difference seen between them, which may grow by
+//this many seconds per second to follow drift between the two.
+const int R_navXUpdateRate = 200;
+const int R_navXHistorySize = 256;
+const double R_navXClockSlew = .001;
+//This is how often in seconds the sampler thread reads every sensor.
+const double R_sensorSamplePeriod = .005;
+//This is how many times a reader which must not spin tries to read a
+//SeqLock before keeping what it had.
+const int R_seqLockReadAttempts = 4;
+//Zion's drive control loop runs every this many seconds, at this real-time
+//(SCHED_FIFO) priority. Without a new setpoint for this many seconds, it
+//stops Zion. It publishes its timing every this many seconds.
+const double R_driveControlPeriod = .005;
+const int R_driveControlPriority = 40;
+const double R_driveCommandTimeout = .1;
+const double R_driveControlPublishPeriod = 1.0;
+/*___End Global Robot Variable Settings___*/
+
+/*_____Simulation Settings_____*/
+//These describe Zion to the desktop simulation's plant models. They do not
+//affect the robot itself. Speeds are at full output on a full battery.
+//The loop period of the simulation in seconds, matching TimedRobot.
+const double R_simLoopPeriod = .02;
+//The top speed of a drive wheel's surface in inches per second, and the time
+//constant in seconds with which it approaches a new speed.
+const double R_simDriveMaxSpeed = 150;
+const double R_simDriveTimeConstant = .12;
+//The fastest a swerve module can turn in degrees per second.
+const double R_simSteerMaxRate = 720;
+//The distance from the center of the drivetrain to each module in inches.
+const double R_simModuleRadius = R_zionModuleRadius;
+//The free speed of the flywheel and the time constant in seconds with which
+//it approaches a new speed.
+const double R_simFlywheelFreeRPM = 4960;
+const double R_simFlywheelTimeConstant = .35;
+//How long in seconds the index takes to push a Power Cell into the
+//flywheel, and how much flywheel speed launching it costs.
+const double R_simIndexFeedTime = .2;
+const double R_simShotDipRPM = 600;
+//The index motor current in amps while pushing a Power Cell, and while empty.
+const double R_simIndexLoadedCurrent = 12;
+const double R_simIndexFreeCurrent = 2;
+//Where the power port is on the field relative to Zion's starting position
+//(i to the right, j forward) in inches, and the target area the Limelight
+//sees times the square of its distance in inches.
+const double R_simTargetPositionI = 0;
+const double R_simTargetPositionJ = 150;
+const double R_simLimelightAreaDistanceSquared = 28800;
+//The most seconds a headless auto run may take before it is stopped.
+const double R_simAutoTimeout = 15;
+//Where recordings are read from and written to in simulation, in place of
+//the USB stick.
+const std::string R_simRecordingDirectory = "recordings/";
+/*___End Simulation Settings___*/
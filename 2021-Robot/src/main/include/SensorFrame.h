@@ -0,0 +1,79 @@
+/*
+struct SensorFrame
+
+Every sensor reading the control code uses, all taken together by
+SensorSampler.
+
+    double time
+        The FPGA time in seconds at which the frame was sampled.
+    uint32_t sequence
+        How many frames had been sampled when this one was; 0 if none has.
+    double yaw
+        The NavX yaw, -180 to 180, clockwise.
+    double roll
+        The NavX roll, -180 to 180.
+    double yawRate
+        The NavX yaw rate as of its latest update, in degrees per second
+        clockwise; 0 if it has sent none.
+    double drivePositions[4]
+        Each module's drive encoder position, indexed by
+        SwerveKinematics::Module.
+    bool climberAtBottom
+    bool swerveUnlockPressed
+        Whether the climber's bottom limit switch and the swerve unlock
+        switch are pressed.
+    uint32_t swerveUnlockPresses
+        How many times the swerve unlock switch has been pressed, as
+        DigitalEdge::getPresses.
+    int ballCount
+        How many Power Cells are on board, as BallCounter::getCount.
+    bool targetVisible
+    double targetHorizontalOffset
+    double targetVerticalOffset
+    double targetArea
+        The Limelight's tv, tx, ty, and ta.
+    double targetCaptureYaw
+        The NavX yaw when the Limelight captured the frame behind them, or
+        the yaw above if that is not known.
+
+    double targetHorizontalOffsetNow() const
+        Returns tx corrected for how far Zion has turned since the frame was
+        captured, which is where the target is now.
+
+    double yawFull() const
+        Returns the yaw from 0-360, as NavX::getYawFull does.
+*/
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+struct SensorFrame {
+
+    double time;
+    uint32_t sequence;
+    double yaw;
+    double roll;
+    double yawRate;
+    double drivePositions[4];
+    bool climberAtBottom;
+    bool swerveUnlockPressed;
+    uint32_t swerveUnlockPresses;
+    int ballCount;
+    bool targetVisible;
+    double targetHorizontalOffset;
+    double targetVerticalOffset;
+    double targetArea;
+    double targetCaptureYaw;
+
+    double yawFull() const {
+
+        return yaw < 0 ? yaw + 360 : yaw;
+    }
+    double targetHorizontalOffsetNow() const {
+
+        //Both are clockwise, so turning right moves the target left.
+        return targetHorizontalOffset - remainder(yaw - targetCaptureYaw, 360);
+    }
+};
@@ -0,0 +1,156 @@
+/*
+class SensorSampler
+
+Constructors
+
+    SensorSampler(SwerveTrain&, NavX&, Limelight&, Climber&, DigitalEdge&, BallCounter&)
+        Creates a sampler for Zion's drive encoders and NavX, the Limelight,
+        the climber's bottom switch, and the supplied swerve unlock switch,
+        which also samples the supplied ball counter.
+
+Public Methods
+
+    void start()
+        Starts the sampler thread, which reads every sensor into a
+        SensorFrame every R_sensorSamplePeriod and publishes it. When
+        simulated, no thread is started and update() samples instead, so
+        that simulated runs repeat exactly.
+    void update()
+        Call once at the beginning of every loop (the top of the mode's
+        periodic function) and of AutonomousInit. Takes the latest frame,
+        which getFrame() then returns for the rest of the loop.
+    const SensorFrame& getFrame()
+        Returns the frame taken by the last update(), so that every decision
+        in a loop is made from the same instant.
+
+Frames are published through a SeqLock, so neither the sampler nor the
+loop ever waits on the other.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <chrono>
+#include <thread>
+
+#include <frc/RobotBase.h>
+#include <frc/Timer.h>
+
+#include "BallCounter.h"
+#include "Climber.h"
+#include "DigitalEdge.h"
+#include "Limelight.h"
+#include "NavX.h"
+#include "RobotMap.h"
+#include "SensorFrame.h"
+#include "SeqLock.h"
+#include "SwerveKinematics.h"
+#include "SwerveTrain.h"
+
+class SensorSampler {
+
+    public:
+        SensorSampler(SwerveTrain &refZion, NavX &refNavX, Limelight &refLimelight, Climber &refClimber, DigitalEdge &refSwerveUnlock, BallCounter &refBallCounter) {
+
+            m_zion = &refZion;
+            m_navX = &refNavX;
+            m_limelight = &refLimelight;
+            m_climber = &refClimber;
+            m_swerveUnlock = &refSwerveUnlock;
+            m_ballCounter = &refBallCounter;
+            memset(&m_frame, 0, sizeof(m_frame));
+            m_sampler = nullptr;
+            m_samples = 0;
+        }
+
+        void start() {
+
+            if (m_sampler != nullptr || frc::RobotBase::IsSimulation()) {
+
+                return;
+            }
+            m_sampler = new std::thread(&SensorSampler::run, this);
+            m_sampler->detach();
+        }
+
+        void update() {
+
+            if (m_sampler == nullptr) {
+
+                m_frame = sample();
+                return;
+            }
+            m_frame = m_published.read();
+        }
+
+        const SensorFrame& getFrame() {
+
+            return m_frame;
+        }
+
+    private:
+        SensorFrame sample() {
+
+            SensorFrame frame;
+            memset(&frame, 0, sizeof(frame));
+            frame.time = frc::Timer::GetFPGATimestamp();
+            frame.sequence = ++m_samples;
+            frame.yaw = m_navX->getYaw();
+            frame.roll = m_navX->getRoll();
+            frame.drivePositions[SwerveKinematics::kFrontRight] = m_zion->m_frontRight->GetDrivePosition();
+            frame.drivePositions[SwerveKinematics::kFrontLeft] = m_zion->m_frontLeft->GetDrivePosition();
+            frame.drivePositions[SwerveKinematics::kRearLeft] = m_zion->m_rearLeft->GetDrivePosition();
+            frame.drivePositions[SwerveKinematics::kRearRight] = m_zion->m_rearRight->GetDrivePosition();
+            frame.climberAtBottom = m_climber->isAtBottom();
+            frame.swerveUnlockPressed = m_swerveUnlock->isPressed();
+            frame.swerveUnlockPresses = m_swerveUnlock->getPresses();
+            //Spikes are brief, so the counter needs every sample.
+            m_ballCounter->sample(frame.time);
+            frame.ballCount = m_ballCounter->getCount();
+            frame.targetVisible = m_limelight->getTarget();
+            frame.targetHorizontalOffset = m_limelight->getHorizontalOffset();
+            frame.targetVerticalOffset = m_limelight->getVerticalOffset();
+            frame.targetArea = m_limelight->getTargetArea();
+            //Look back through the NavX's updates for the Limelight's
+            //capture, so that its offsets can be brought up to now.
+            NavXSample navXSample;
+            if (m_navX->getLatestSample(navXSample)) {
+
+                frame.yawRate = navXSample.yawRate;
+            }
+            frame.targetCaptureYaw = frame.yaw;
+            if (frame.targetVisible && m_navX->getSampleAt(frame.time - m_limelight->getLatency(), navXSample)) {
+
+                frame.targetCaptureYaw = navXSample.yaw;
+            }
+            return frame;
+        }
+
+        void run() {
+
+            std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+            std::chrono::steady_clock::duration period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(R_sensorSamplePeriod));
+            while (true) {
+
+                m_published.write(sample());
+                next += period;
+                std::this_thread::sleep_until(next);
+            }
+        }
+
+        SwerveTrain *m_zion;
+        NavX *m_navX;
+        Limelight *m_limelight;
+        Climber *m_climber;
+        DigitalEdge *m_swerveUnlock;
+        BallCounter *m_ballCounter;
+
+        SeqLock<SensorFrame> m_published;
+        //Only the sampler (or, when simulated, update()) counts samples.
+        uint32_t m_samples;
+        std::thread *m_sampler;
+        //The frame for this loop.
+        SensorFrame m_frame;
+};
@@ -0,0 +1,113 @@
+/*
+template <typename T> class SeqLock
+
+Constructors
+
+    SeqLock()
+        Creates a seqlock holding a zeroed T, which must be trivially
+        copyable.
+
+Public Methods
+
+    void write(const T&)
+        Publishes the supplied value. Only one thread may write.
+    T read()
+        Returns the latest value, retrying until it has a copy no write
+        overlapped.
+    bool tryRead(T&)
+        As read(), but gives up after R_seqLockReadAttempts tries and
+        returns false, leaving the supplied value alone. For readers which
+        must not spin on a writer they could preempt, such as one at a
+        higher priority.
+
+The writer makes the sequence odd, writes the value, then makes it even. A
+reader copies the value and keeps the copy only if the sequence was even
+and unchanged around it. Neither side locks. The value is kept as atomic
+words, so a copy which races with a write is well-defined (and discarded).
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+#include <type_traits>
+
+#include "RobotMap.h"
+
+template <typename T> class SeqLock {
+
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock values are copied as words, so must be trivially copyable");
+
+    public:
+        SeqLock() : m_sequence(0) {
+
+            for (std::atomic<uint64_t> &word : m_words) {
+
+                word.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        void write(const T &value) {
+
+            uint64_t words[kWords] = {};
+            memcpy(words, &value, sizeof(T));
+
+            //Odd while writing, so readers know to retry.
+            uint32_t sequence = m_sequence.load(std::memory_order_relaxed);
+            m_sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (int word = 0; word < kWords; ++word) {
+
+                m_words[word].store(words[word], std::memory_order_relaxed);
+            }
+            m_sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+        T read() {
+
+            T value;
+            while (!attempt(value));
+            return value;
+        }
+
+        bool tryRead(T &value) {
+
+            for (int attempts = 0; attempts < R_seqLockReadAttempts; ++attempts) {
+
+                if (attempt(value)) {
+
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+        static const int kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        bool attempt(T &value) {
+
+            uint32_t before = m_sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+
+                return false;
+            }
+            uint64_t words[kWords];
+            for (int word = 0; word < kWords; ++word) {
+
+                words[word] = m_words[word].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_sequence.load(std::memory_order_relaxed) != before) {
+
+                return false;
+            }
+            memcpy(&value, words, sizeof(T));
+            return true;
+        }
+
+        std::atomic<uint32_t> m_sequence;
+        std::atomic<uint64_t> m_words[kWords];
+};
@@ -0,0 +1,126 @@
+/*
+class ShotCompensator
+
+Constructors
+
+    ShotCompensator(SensorSampler&, ChassisVelocityEstimator&)
+        Creates a compensator which leads the Limelight's target, as read
+        from the supplied sampler's frame, by Zion's estimated velocity, so
+        that Power Cells launched while moving still reach it.
+
+Public Methods
+
+    ShotCompensator::Solution solve()
+        Returns where to aim and how to launch for the current target and
+        velocity. With no target in sight, or while standing still, this is
+        simply the Limelight's own offset (turned for the time since its
+        capture) and area.
+
+    struct Solution
+        offset: the horizontal offset in degrees to lock on to, in place of tx.
+        area: the target area to look up in the LauncherModel in place of ta.
+        launcher: that LauncherModel lookup.
+        launchScale: how much faster (or slower) than at a standstill to spin
+        the flywheel, within R_launcherLeadMaxScale either way.
+
+A Power Cell keeps Zion's velocity when launched, so over its time of flight
+it drifts by that velocity times the time. Aiming at the target moved back by
+that drift cancels it. The time of flight depends on the distance to that
+aim point, so the two are solved together over a few iterations. The model
+is calibrated in target area rather than distance, so the aim point's area
+is taken from the real one by the inverse square of the distances.
+
+Every calibration point was shot at one launch speed, so the hood alone
+covers the distances between them, and the launch speed stays as it is.
+Only past the nearest or farthest calibration point does the hood stop
+short. There the launch speed is scaled by how much farther (or nearer) the
+aim point lies past the hood's reach than the target itself does. A Power
+Cell's range at a fixed angle goes with the square of its speed, so the
+scale is the square root of that ratio. At a standstill the two are the
+same, and the scale is 1.
+
+The Limelight's tx is as of its capture, tens of milliseconds ago, so it is
+first corrected by how far the NavX says Zion has turned since
+(SensorFrame::targetHorizontalOffsetNow).
+*/
+
+#pragma once
+
+#include <math.h>
+
+#include "ChassisVelocityEstimator.h"
+#include "LauncherModel.h"
+#include "SensorSampler.h"
+#include "RobotMap.h"
+#include "VectorDouble.h"
+
+class ShotCompensator {
+
+    public:
+        ShotCompensator(SensorSampler &refSensors, ChassisVelocityEstimator &refVelocity) {
+
+            m_sensors = &refSensors;
+            m_velocity = &refVelocity;
+        }
+
+        struct Solution {
+
+            double offset;
+            double area;
+            LauncherModel::Solution launcher;
+            double launchScale;
+        };
+
+        Solution solve() {
+
+            const SensorFrame &frame = m_sensors->getFrame();
+            double tx = frame.targetHorizontalOffsetNow();
+            double area = frame.targetArea;
+            LauncherModel::Solution standing = LauncherModel::solve(area);
+            Solution solution {tx, area, standing, 1.0};
+
+            double elevation = (R_limelightMountAngle + frame.targetVerticalOffset) * M_PI / 180;
+            if (!frame.targetVisible || elevation <= 0) {
+
+                return solution;
+            }
+            //Find the target relative to the robot, i toward its right and j
+            //toward its front...
+            double distance = (R_limelightTargetHeight - R_limelightMountHeight) / tan(elevation);
+            VectorDouble target(distance * sin(tx * M_PI / 180), distance * cos(tx * M_PI / 180));
+            VectorDouble velocity = m_velocity->getVelocity();
+
+            //Then walk the aim point back by the drift over the time of flight
+            //to it, until the two agree.
+            VectorDouble aim = target;
+            LauncherModel::Solution launcher = standing;
+            double aimDistance = distance;
+            for (int i = 0; i < R_launcherLeadIterations; ++i) {
+
+                double timeOfFlight = aimDistance / (R_launcherBallHorizontalSpeedPerRPM * launcher.rpm);
+                aim = target - velocity.scaled(timeOfFlight);
+                aimDistance = aim.magnitude();
+                solution.area = area * (distance * distance) / (aimDistance * aimDistance);
+                launcher = LauncherModel::solve(solution.area);
+            }
+            solution.offset = atan2(aim.i, aim.j) * 180 / M_PI;
+            solution.launcher = launcher;
+            double scale = sqrt(pastReach(solution.area) / pastReach(area));
+            solution.launchScale = fmax(1 / R_launcherLeadMaxScale, fmin(R_launcherLeadMaxScale, scale));
+            return solution;
+        }
+
+    private:
+        //How many times the hood's reach the distance to a target of the
+        //supplied area is: 1 within the calibrated areas, and otherwise the
+        //distance over that to the nearest calibrated area.
+        static double pastReach(const double &area) {
+
+            double nearest = fmax(R_launcherCalibration[0].area, fmin(R_launcherCalibration[R_launcherCalibrationCount - 1].area, area));
+            //Area goes with the inverse square of distance.
+            return sqrt(nearest / area);
+        }
+
+        SensorSampler* m_sensors;
+        ChassisVelocityEstimator* m_velocity;
+};
@@ -0,0 +1,89 @@
+/*
+struct SpeedCurve
+
+The piecewise speed curve used wherever Zion closes in on a target: a
+sigmoid while far away, then a fixed speed once within the first end
+behavior, a slower one within the second, and stopped within tolerance.
+
+Public Members
+
+    double tolerance
+    double firstEndBehaviorAt
+    double firstEndBehaviorSpeed
+    double secondEndBehaviorAt
+    double secondEndBehaviorSpeed
+        The breakpoints, in whatever unit the remaining distance is in, and
+        the speeds within them.
+
+Public Methods
+
+    double speed(const double&)
+        Returns the speed (0-1) for the supplied remaining distance, with its
+        sign.
+
+The families of constants are in SpeedCurveConstants.h; the curves built
+from them are below.
+*/
+
+#pragma once
+
+#include <math.h>
+
+#include "RobotMap.h"
+
+struct SpeedCurve {
+
+    double tolerance;
+    double firstEndBehaviorAt;
+    double firstEndBehaviorSpeed;
+    double secondEndBehaviorAt;
+    double secondEndBehaviorSpeed;
+
+    double speed(const double &remaining) const {
+
+        double distance = fabs(remaining);
+        //Begin with the sigmoid, horizontally stretched by a factor of two...
+        double toReturn = 1 / (1 + exp(-(.5 * fabs(.5 * distance)) + 5));
+        //Then take the end behaviors' speeds when within them...
+        if (distance < firstEndBehaviorAt) {
+
+            toReturn = firstEndBehaviorSpeed;
+        }
+        if (distance < secondEndBehaviorAt) {
+
+            toReturn = secondEndBehaviorSpeed;
+        }
+        if (distance < tolerance) {
+
+            toReturn = 0;
+        }
+        //And go the way that is remaining.
+        return remaining < 0 ? -toReturn : toReturn;
+    }
+};
+
+constexpr SpeedCurve R_speedCurveAssumePosition = {
+
+    R_swerveTrainAssumePositionTolerance,
+    R_swerveTrainAssumePositionSpeedCalculationFirstEndBehaviorAt,
+    R_swerveTrainAssumePositionSpeedCalculationFirstEndBehaviorSpeed,
+    R_swerveTrainAssumePositionSpeedCalculationSecondEndBehaviorAt,
+    R_swerveTrainAssumePositionSpeedCalculationSecondEndBehaviorSpeed
+};
+//The lock is centered once within the Limelight's horizontal tolerance.
+constexpr SpeedCurve R_speedCurveLimelightLock = {
+
+    R_zionAutoToleranceHorizontalOffset,
+    R_swerveTrainLimelightLockPositionSpeedCalculatonFirstEndBehaviorAt,
+    R_swerveTrainLimelightLockPositionSpeedCalculatonFirstEndBehaviorSpeed,
+    R_swerveTrainLimelightLockPositionSpeedCalculatonSecondEndBehaviorAt,
+    R_swerveTrainLimelightLockPositionSpeedCalculatonSecondEndBehaviorSpeed
+};
+constexpr SpeedCurve R_speedCurveHoldAngle = {
+
+    R_swerveTrainHoldAngleTolerance,
+    R_swerveTrainHoldAngleSpeedCalculatonFirstEndBehaviorAt,
+    R_swerveTrainHoldAngleSpeedCalculatonFirstEndBehaviorSpeed,
+    R_swerveTrainHoldAngleSpeedCalculatonSecondEndBehaviorAt,
+    R_swerveTrainHoldAngleSpeedCalculatonSecondEndBehaviorSpeed
+};
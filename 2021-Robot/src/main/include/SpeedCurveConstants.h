@@ -0,0 +1,29 @@
+//SpeedCurveConstants: The tolerances, end behavior breakpoints, and speeds of
+//Zion's speed curves (see SpeedCurve.h). These are the hand-picked values;
+//TuneSpeedCurves regenerates this file with values searched for against the
+//simulation's plants.
+
+#pragma once
+
+//For assuming a position, in motor rotations.
+const double R_swerveTrainAssumePositionTolerance = .25;
+const double R_swerveTrainAssumePositionSpeedCalculationFirstEndBehaviorAt = 3.5;
+const double R_swerveTrainAssumePositionSpeedCalculationFirstEndBehaviorSpeed = .2;
+const double R_swerveTrainAssumePositionSpeedCalculationSecondEndBehaviorAt = 1;
+const double R_swerveTrainAssumePositionSpeedCalculationSecondEndBehaviorSpeed = .02;
+
+//For locking on to the Limelight's target, in degrees. The curve is tuned to stop
+//within R_zionAutoToleranceHorizontalOffset, which R_speedCurveLimelightLock uses
+//in place of this tolerance.
+const double R_swerveTrainLimelightLockTolerance = 1;
+const double R_swerveTrainLimelightLockPositionSpeedCalculatonFirstEndBehaviorAt = 5.0;
+const double R_swerveTrainLimelightLockPositionSpeedCalculatonFirstEndBehaviorSpeed = .05;
+const double R_swerveTrainLimelightLockPositionSpeedCalculatonSecondEndBehaviorAt = 2.5;
+const double R_swerveTrainLimelightLockPositionSpeedCalculatonSecondEndBehaviorSpeed = .025;
+
+//For holding an angle, in degrees.
+const double R_swerveTrainHoldAngleTolerance = 1.0;
+const double R_swerveTrainHoldAngleSpeedCalculatonFirstEndBehaviorAt = 10.0;
+const double R_swerveTrainHoldAngleSpeedCalculatonFirstEndBehaviorSpeed = .075;
+const double R_swerveTrainHoldAngleSpeedCalculatonSecondEndBehaviorAt = 5.0;
+const double R_swerveTrainHoldAngleSpeedCalculatonSecondEndBehaviorSpeed = .075;
@@ -0,0 +1,57 @@
+/*
+struct StatusFramePeriods
+
+Public Functions
+
+    static void apply(rev::CANSparkMax*, const StatusFramePeriods::Profile&)
+        Sets how often the supplied SPARK MAX sends each of its periodic
+        status frames, according to what is read from it:
+
+        Status 0 carries applied output and faults.
+        Status 1 carries velocity, current, temperature, and voltage.
+        Status 2 carries position.
+
+    enum Profile
+        kDrive: position and velocity both fresh, for distance travelled.
+        kSteer: position fresh, for module angle.
+        kFlywheel: velocity fresh, for RPM; position is never read.
+        kCurrentSensed: current fresh, for detecting load; no encoder.
+        kOpenLoop: nothing is read, so everything is slow.
+
+Every frame a controller does not need is bus time the drive frames can use,
+so the slow periods are as slow as the controller allows while still being
+seen by the driver station.
+*/
+
+#pragma once
+
+#include <rev/CANSparkMax.h>
+
+struct StatusFramePeriods {
+
+    enum Profile {
+
+        kDrive,
+        kSteer,
+        kFlywheel,
+        kCurrentSensed,
+        kOpenLoop
+    };
+
+    static void apply(rev::CANSparkMax *motor, const Profile &profile) {
+
+        //Periods in milliseconds of status 0, 1, then 2.
+        int periods[3];
+        switch (profile) {
+
+            case kDrive:            periods[0] = 10;  periods[1] = 10;  periods[2] = 10;  break;
+            case kSteer:            periods[0] = 10;  periods[1] = 20;  periods[2] = 10;  break;
+            case kFlywheel:         periods[0] = 10;  periods[1] = 10;  periods[2] = 500; break;
+            case kCurrentSensed:    periods[0] = 20;  periods[1] = 10;  periods[2] = 500; break;
+            case kOpenLoop:         periods[0] = 100; periods[1] = 500; periods[2] = 500; break;
+        }
+        motor->SetPeriodicFramePeriod(rev::CANSparkMaxLowLevel::PeriodicFrame::kStatus0, periods[0]);
+        motor->SetPeriodicFramePeriod(rev::CANSparkMaxLowLevel::PeriodicFrame::kStatus1, periods[1]);
+        motor->SetPeriodicFramePeriod(rev::CANSparkMaxLowLevel::PeriodicFrame::kStatus2, periods[2]);
+    }
+};
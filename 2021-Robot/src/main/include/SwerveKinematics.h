@@ -0,0 +1,184 @@
+/*
+class SwerveKinematics
+
+Public Functions
+
+    void solve(const float&, const float&, const float&, const SwerveKinematics::ModuleStates&, SwerveKinematics::ModuleStates&)
+        Computes the speed and angle of all four modules for the supplied
+        translation (x, y, as given to SwerveTrain::Drive) and rotation (z,
+        clockwise). The second argument is where the modules are pointing
+        now, and the result is written to the third, which may be the same
+        object. Speeds are scaled down together if any exceeds 1, and each
+        module is reversed rather than turned more than 90 degrees.
+    void solveScalar(const float&, const float&, const float&, const SwerveKinematics::ModuleStates&, SwerveKinematics::ModuleStates&)
+        The same, always by the plain loops, which solve() uses where SSE is
+        not available. For checking one against the other.
+
+    struct ModuleStates
+        The four modules in structure-of-arrays form, indexed by kFrontRight,
+        kFrontLeft, kRearLeft, and kRearRight. Speeds are -1 to 1, angles are
+        degrees on the unit circle (0 toward the robot's right, 90 toward its
+        front), 0-360.
+
+All four modules are computed together: one four-wide SSE operation per
+step where SSE is available (desktop builds), and otherwise plain
+fixed-length loops over float arrays, as on the roboRIO. The build passes no
+flags for vectorizing those loops, and benchSwerveKinematics measures no
+gain from SSE either, so this is no faster than solving each module in turn.
+Floats are far more precise than the motor controllers.
+
+Nothing in the robot program calls this yet: SwerveTrain::Drive still works
+out its modules with its own scalar code. It is used by the unit tests and
+benchSwerveKinematics.
+*/
+
+#pragma once
+
+#include <math.h>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+#include "RobotMap.h"
+
+class SwerveKinematics {
+
+    public:
+        enum Module {
+
+            kFrontRight,
+            kFrontLeft,
+            kRearLeft,
+            kRearRight
+        };
+
+        struct ModuleStates {
+
+            alignas(16) float speed[4];
+            alignas(16) float angle[4];
+        };
+
+        static void solve(const float &x, const float &y, const float &z, const ModuleStates &current, ModuleStates &result) {
+
+#if defined(__SSE__)
+            alignas(16) float i[4];
+            alignas(16) float j[4];
+            alignas(16) float speed[4];
+            const Geometry &geometry = getGeometry();
+
+            //Each module moves with the chassis plus its rotation about the
+            //center, which is perpendicular to the module's position.
+            __m128 moduleI = _mm_add_ps(_mm_set1_ps(x), _mm_mul_ps(_mm_set1_ps(z), _mm_load_ps(geometry.rotationI)));
+            __m128 moduleJ = _mm_add_ps(_mm_set1_ps(y), _mm_mul_ps(_mm_set1_ps(z), _mm_load_ps(geometry.rotationJ)));
+            __m128 moduleSpeed = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(moduleI, moduleI), _mm_mul_ps(moduleJ, moduleJ)));
+            //Find the fastest module by folding the four lanes together.
+            __m128 fastest = _mm_max_ps(moduleSpeed, _mm_shuffle_ps(moduleSpeed, moduleSpeed, _MM_SHUFFLE(2, 3, 0, 1)));
+            fastest = _mm_max_ps(fastest, _mm_shuffle_ps(fastest, fastest, _MM_SHUFFLE(1, 0, 3, 2)));
+            //No module may exceed full speed, so if one would, all are scaled
+            //down by the same amount to keep the motion the same shape.
+            __m128 scale = _mm_div_ps(_mm_set1_ps(1), _mm_max_ps(fastest, _mm_set1_ps(1)));
+            _mm_store_ps(i, moduleI);
+            _mm_store_ps(j, moduleJ);
+            _mm_store_ps(speed, _mm_mul_ps(moduleSpeed, scale));
+            turnModules(i, j, speed, current, result);
+#else
+            solveScalar(x, y, z, current, result);
+#endif
+        }
+
+        static void solveScalar(const float &x, const float &y, const float &z, const ModuleStates &current, ModuleStates &result) {
+
+            alignas(16) float i[4];
+            alignas(16) float j[4];
+            alignas(16) float speed[4];
+            const Geometry &geometry = getGeometry();
+
+            float fastest = 1;
+            for (int k = 0; k < 4; ++k) {
+
+                i[k] = x + z * geometry.rotationI[k];
+                j[k] = y + z * geometry.rotationJ[k];
+                speed[k] = sqrtf(i[k] * i[k] + j[k] * j[k]);
+            }
+            for (int k = 0; k < 4; ++k) {
+
+                fastest = speed[k] > fastest ? speed[k] : fastest;
+            }
+            for (int k = 0; k < 4; ++k) {
+
+                speed[k] /= fastest;
+            }
+            turnModules(i, j, speed, current, result);
+        }
+
+    private:
+        //Points each module along its velocity, by the shorter way round.
+        static void turnModules(const float *i, const float *j, float *speed, const ModuleStates &current, ModuleStates &result) {
+
+            for (int k = 0; k < 4; ++k) {
+
+                //A module with nowhere to go stays where it is pointed.
+                if (speed[k] == 0) {
+
+                    result.speed[k] = 0;
+                    result.angle[k] = current.angle[k];
+                    continue;
+                }
+                float angle = atan2f(j[k], i[k]) * (180 / (float)M_PI);
+                //Turning a module more than 90 degrees is never needed: the
+                //opposite angle with the drive reversed moves the same way.
+                float turn = angle - current.angle[k];
+                turn -= 360 * floorf((turn + 180) / 360);
+                if (turn > 90) {
+
+                    turn -= 180;
+                    speed[k] = -speed[k];
+                }
+                else if (turn < -90) {
+
+                    turn += 180;
+                    speed[k] = -speed[k];
+                }
+                angle = current.angle[k] + turn;
+                result.speed[k] = speed[k];
+                result.angle[k] = angle - 360 * floorf(angle / 360);
+            }
+        }
+
+        //The velocity of each module per unit of clockwise rotation, which is
+        //its position about the center turned 90 degrees clockwise. Positions
+        //are on the unit circle at R_angleFromCenterTo...Wheel, which are
+        //measured counterclockwise from the front.
+        struct Geometry {
+
+            alignas(16) float rotationI[4];
+            alignas(16) float rotationJ[4];
+        };
+
+        static const Geometry& getGeometry() {
+
+            static const Geometry geometry = makeGeometry();
+            return geometry;
+        }
+
+        static Geometry makeGeometry() {
+
+            double angles[4];
+            angles[kFrontRight] = R_angleFromCenterToFrontRightWheel;
+            angles[kFrontLeft] = R_angleFromCenterToFrontLeftWheel;
+            angles[kRearLeft] = R_angleFromCenterToRearLeftWheel;
+            angles[kRearRight] = R_angleFromCenterToRearRightWheel;
+
+            Geometry geometry;
+            for (int k = 0; k < 4; ++k) {
+
+                double radians = angles[k] * (M_PI / 180);
+                double positionI = -sin(radians);
+                double positionJ = cos(radians);
+                geometry.rotationI[k] = positionJ;
+                geometry.rotationJ[k] = -positionI;
+            }
+            return geometry;
+        }
+};
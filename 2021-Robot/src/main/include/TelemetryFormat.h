@@ -0,0 +1,213 @@
+/*
+class TelemetryEncoder / class TelemetryDecoder
+
+The binary format of the telemetry log, kept free of WPILib so the desktop
+decoder can share it. A file is the magic "ZTLM" and a version byte, then
+entries, each beginning with a varint:
+
+    0, id, length, name      Defines signal id as name (before its first
+                             record in each file).
+    id + 1, dt, bits         A record: microseconds since the previous
+                             record in the file, and the value's float bits
+                             XORed with that signal's previous bits.
+
+Varints are little-endian base 128. An unchanged value therefore costs one
+byte, and a loop's worth of records a few bytes each. Every file decodes on
+its own; times are microseconds since the logger started.
+
+TelemetryEncoder
+
+    void begin(std::string&)
+        Appends the file header, and forgets everything previously encoded.
+    void define(std::string&, const uint32_t&, const std::string&)
+    void record(std::string&, const uint64_t&, const uint32_t&, const float&)
+        Appends an entry.
+    bool isDefined(const uint32_t&)
+        Returns true if the signal has been defined since begin().
+
+TelemetryDecoder
+
+    bool begin(const std::string&, size_t&)
+        Checks the file header at the supplied offset and moves past it.
+    int next(const std::string&, size_t&, TelemetryDecoder::Entry&)
+        Decodes the entry at the supplied offset into the supplied entry and
+        moves past it. Returns kRecord, kDefinition, kEnd, or kCorrupt.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+class TelemetryFormat {
+
+    public:
+        static constexpr const char* kMagic = "ZTLM";
+        static constexpr uint8_t kVersion = 1;
+
+        static void putVarint(std::string &out, uint64_t value) {
+
+            while (value >= 0x80) {
+
+                out.push_back((char)(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back((char)value);
+        }
+
+        static bool getVarint(const std::string &in, size_t &offset, uint64_t &value) {
+
+            value = 0;
+            for (int shift = 0; shift < 64 && offset < in.size(); shift += 7) {
+
+                uint8_t byte = in[offset++];
+                value |= (uint64_t)(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) {
+
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static uint32_t toBits(const float &value) {
+
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        static float fromBits(const uint32_t &bits) {
+
+            float value;
+            memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+};
+
+class TelemetryEncoder {
+
+    public:
+        void begin(std::string &out) {
+
+            out.append(TelemetryFormat::kMagic, 4);
+            out.push_back((char)TelemetryFormat::kVersion);
+            m_lastTime = 0;
+            m_lastBits.clear();
+            m_defined.clear();
+        }
+
+        void define(std::string &out, const uint32_t &signal, const std::string &name) {
+
+            TelemetryFormat::putVarint(out, 0);
+            TelemetryFormat::putVarint(out, signal);
+            TelemetryFormat::putVarint(out, name.size());
+            out.append(name);
+            if (signal >= m_defined.size()) {
+
+                m_defined.resize(signal + 1, false);
+                m_lastBits.resize(signal + 1, 0);
+            }
+            m_defined[signal] = true;
+        }
+
+        void record(std::string &out, const uint64_t &time, const uint32_t &signal, const float &value) {
+
+            uint32_t bits = TelemetryFormat::toBits(value);
+            TelemetryFormat::putVarint(out, (uint64_t)signal + 1);
+            //Records come from one thread in order, but guard against a clock
+            //step backward rather than writing a huge delta.
+            TelemetryFormat::putVarint(out, time > m_lastTime ? time - m_lastTime : 0);
+            TelemetryFormat::putVarint(out, bits ^ m_lastBits[signal]);
+            m_lastTime = time > m_lastTime ? time : m_lastTime;
+            m_lastBits[signal] = bits;
+        }
+
+        bool isDefined(const uint32_t &signal) {
+
+            return signal < m_defined.size() && m_defined[signal];
+        }
+
+    private:
+        uint64_t m_lastTime = 0;
+        std::vector<uint32_t> m_lastBits;
+        std::vector<bool> m_defined;
+};
+
+class TelemetryDecoder {
+
+    public:
+        enum Result {
+
+            kRecord,
+            kDefinition,
+            kEnd,
+            kCorrupt
+        };
+
+        struct Entry {
+
+            uint64_t time;
+            uint32_t signal;
+            float value;
+            std::string name;
+        };
+
+        bool begin(const std::string &in, size_t &offset) {
+
+            m_lastTime = 0;
+            m_lastBits.clear();
+            if (in.size() < offset + 5 || in.compare(offset, 4, TelemetryFormat::kMagic) != 0 || (uint8_t)in[offset + 4] != TelemetryFormat::kVersion) {
+
+                return false;
+            }
+            offset += 5;
+            return true;
+        }
+
+        int next(const std::string &in, size_t &offset, Entry &entry) {
+
+            if (offset >= in.size()) {
+
+                return kEnd;
+            }
+            uint64_t tag, a, b;
+            if (!TelemetryFormat::getVarint(in, offset, tag) || !TelemetryFormat::getVarint(in, offset, a) || !TelemetryFormat::getVarint(in, offset, b)) {
+
+                return kCorrupt;
+            }
+            if (tag == 0) {
+
+                //a is the signal, b the length of its name.
+                if (offset + b > in.size()) {
+
+                    return kCorrupt;
+                }
+                entry.signal = a;
+                entry.name = in.substr(offset, b);
+                offset += b;
+                if (entry.signal >= m_lastBits.size()) {
+
+                    m_lastBits.resize(entry.signal + 1, 0);
+                }
+                return kDefinition;
+            }
+            entry.signal = tag - 1;
+            if (entry.signal >= m_lastBits.size()) {
+
+                return kCorrupt;
+            }
+            m_lastTime += a;
+            m_lastBits[entry.signal] ^= (uint32_t)b;
+            entry.time = m_lastTime;
+            entry.value = TelemetryFormat::fromBits(m_lastBits[entry.signal]);
+            return kRecord;
+        }
+
+    private:
+        uint64_t m_lastTime = 0;
+        std::vector<uint32_t> m_lastBits;
+};
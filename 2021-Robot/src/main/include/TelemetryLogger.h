@@ -0,0 +1,290 @@
+/*
+class TelemetryLogger
+
+Constructors
+
+    TelemetryLogger()
+        Creates a logger with an empty buffer. Nothing is written until
+        start().
+
+Public Methods
+
+    uint32_t addSignal(const std::string&)
+        Registers a signal by name and returns its id. Signals may be added
+        at any time, though usually before start().
+    void log(const uint32_t&, const double&)
+        Records the signal's value, timestamped now. Wait-free: this only
+        copies sixteen bytes into the buffer, and if the buffer is full the
+        record is dropped and counted rather than waited on. Only one thread
+        (the control loop) may log.
+    void start(const std::string&)
+        Starts the background writer, which writes the buffer every
+        R_telemetryFlushPeriod to telemetry-<session>-<part>.bin files in
+        the supplied directory (under /u/ on the robot). Each session takes
+        the number after the highest already in the directory, begins a new
+        part every R_telemetryFileBytes, and keeps its last
+        R_telemetryFilesKept parts. Sessions older than the last
+        R_telemetrySessionsKept are deleted when it begins.
+    long getDropped()
+        Returns how many records have been dropped for a full buffer.
+
+class TelemetrySignal
+
+    TelemetrySignal(TelemetryLogger&, const std::string&)
+        Registers a signal with the supplied logger.
+    void log(const double&)
+        Records its value.
+
+The writer runs at the lowest priority and encodes with TelemetryEncoder
+(see TelemetryFormat.h); DecodeTelemetry turns the files back into CSV.
+Finding sessions lists the directory, which is only done on Linux (the robot
+and simulation there); elsewhere a session is found by its first part, and
+old sessions are not deleted.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <frc/DriverStation.h>
+
+#include "RobotMap.h"
+#include "TelemetryFormat.h"
+
+static_assert((R_telemetryBufferRecords & (R_telemetryBufferRecords - 1)) == 0, "R_telemetryBufferRecords must be a power of two");
+
+class TelemetryLogger {
+
+    public:
+        TelemetryLogger() : m_head(0), m_tail(0), m_dropped(0) {
+
+            m_records = new Record[R_telemetryBufferRecords];
+            m_start = std::chrono::steady_clock::now();
+            m_writer = nullptr;
+        }
+
+        uint32_t addSignal(const std::string &name) {
+
+            std::lock_guard<std::mutex> lock(m_namesMutex);
+            m_names.push_back(name);
+            return m_names.size() - 1;
+        }
+
+        void log(const uint32_t &signal, const double &value) {
+
+            //Only this thread moves the head, so it can be read relaxed; the
+            //tail needs acquire so the writer is done with the slot.
+            uint32_t head = m_head.load(std::memory_order_relaxed);
+            if (head - m_tail.load(std::memory_order_acquire) >= R_telemetryBufferRecords) {
+
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            Record &record = m_records[head & (R_telemetryBufferRecords - 1)];
+            record.time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count();
+            record.signal = signal;
+            record.value = (float)value;
+            //Publish the record to the writer.
+            m_head.store(head + 1, std::memory_order_release);
+        }
+
+        void start(const std::string &directory) {
+
+            if (m_writer != nullptr) {
+
+                return;
+            }
+            m_directory = directory;
+            m_writer = new std::thread(&TelemetryLogger::run, this);
+            m_writer->detach();
+        }
+
+        long getDropped() {
+
+            return m_dropped.load(std::memory_order_relaxed);
+        }
+
+    private:
+        struct Record {
+
+            uint64_t time;
+            uint32_t signal;
+            float value;
+        };
+
+        std::string pathTo(const int &session, const int &part) {
+
+            return m_directory + "telemetry-" + std::to_string(session) + "-" + std::to_string(part) + ".bin";
+        }
+
+        //The parts of every session in the directory, by session number.
+        std::map<int, std::vector<int>> findSessions() {
+
+            std::map<int, std::vector<int>> sessions;
+#if defined(__linux__)
+            DIR *directory = opendir(m_directory.c_str());
+            if (directory == nullptr) {
+
+                return sessions;
+            }
+            while (dirent *entry = readdir(directory)) {
+
+                std::string name = entry->d_name;
+                int session;
+                int part;
+                if (name.size() > 4 && name.compare(name.size() - 4, 4, ".bin") == 0 && sscanf(name.c_str(), "telemetry-%d-%d", &session, &part) == 2) {
+
+                    sessions[session].push_back(part);
+                }
+            }
+            closedir(directory);
+#else
+            for (int session = 0; std::ifstream(pathTo(session, 0)).good(); ++session) {
+
+                sessions[session].push_back(0);
+            }
+#endif
+            return sessions;
+        }
+
+        //Takes the next session number, deleting the oldest sessions to
+        //make room for it.
+        int beginSession() {
+
+            std::map<int, std::vector<int>> sessions = findSessions();
+            int session = sessions.empty() ? 0 : sessions.rbegin()->first + 1;
+#if defined(__linux__)
+            int excess = (int)sessions.size() + 1 - R_telemetrySessionsKept;
+            for (auto old = sessions.begin(); excess > 0 && old != sessions.end(); ++old, --excess) {
+
+                for (int part : old->second) {
+
+                    std::remove(pathTo(old->first, part).c_str());
+                }
+            }
+#endif
+            return session;
+        }
+
+        void run() {
+
+#if defined(__linux__)
+            //Stay out of the control loop's way; nice applies per thread here.
+            setpriority(PRIO_PROCESS, syscall(SYS_gettid), 19);
+#endif
+            int session = beginSession();
+            int part = 0;
+            long written = 0;
+            std::ofstream file;
+            TelemetryEncoder encoder;
+            std::string buffer;
+            std::vector<std::string> names;
+            bool reported = false;
+
+            while (true) {
+
+                std::this_thread::sleep_for(std::chrono::duration<double>(R_telemetryFlushPeriod));
+
+                if (!file.is_open()) {
+
+                    file.open(pathTo(session, part), std::ios::out | std::ios::binary | std::ios::trunc);
+                    if (!file.is_open()) {
+
+                        if (!reported) {
+
+                            frc::DriverStation::ReportError("Unable to open " + pathTo(session, part) + " for telemetry");
+                            reported = true;
+                        }
+                        //Keep draining, so logging never fills the buffer.
+                        m_tail.store(m_head.load(std::memory_order_acquire), std::memory_order_release);
+                        continue;
+                    }
+                    buffer.clear();
+                    encoder.begin(buffer);
+                    written = 0;
+                }
+
+                uint32_t tail = m_tail.load(std::memory_order_relaxed);
+                uint32_t head = m_head.load(std::memory_order_acquire);
+                for (; tail != head; ++tail) {
+
+                    const Record &record = m_records[tail & (R_telemetryBufferRecords - 1)];
+                    if (!encoder.isDefined(record.signal)) {
+
+                        if (record.signal >= names.size()) {
+
+                            std::lock_guard<std::mutex> lock(m_namesMutex);
+                            names = m_names;
+                        }
+                        encoder.define(buffer, record.signal, record.signal < names.size() ? names[record.signal] : "Signal::" + std::to_string(record.signal));
+                    }
+                    encoder.record(buffer, record.time, record.signal, record.value);
+                }
+                //Hand the slots back before the slow part.
+                m_tail.store(tail, std::memory_order_release);
+
+                file.write(buffer.data(), buffer.size());
+                file.flush();
+                written += buffer.size();
+                buffer.clear();
+
+                if (written >= R_telemetryFileBytes) {
+
+                    file.close();
+                    part++;
+                    if (part >= R_telemetryFilesKept) {
+
+                        std::remove(pathTo(session, part - R_telemetryFilesKept).c_str());
+                    }
+                }
+            }
+        }
+
+        //The head and tail are on their own cache lines, as each is written
+        //by a different thread.
+        alignas(64) std::atomic<uint32_t> m_head;
+        alignas(64) std::atomic<uint32_t> m_tail;
+        alignas(64) std::atomic<long> m_dropped;
+        Record *m_records;
+        std::chrono::steady_clock::time_point m_start;
+        std::mutex m_namesMutex;
+        std::vector<std::string> m_names;
+        std::string m_directory;
+        std::thread *m_writer;
+};
+
+class TelemetrySignal {
+
+    public:
+        TelemetrySignal(TelemetryLogger &logger, const std::string &name) {
+
+            m_logger = &logger;
+            m_signal = logger.addSignal(name);
+        }
+
+        void log(const double &value) {
+
+            m_logger->log(m_signal, value);
+        }
+
+    private:
+        TelemetryLogger *m_logger;
+        uint32_t m_signal;
+};
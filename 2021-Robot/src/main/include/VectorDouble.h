@@ -1,8 +1,13 @@
 /*
 struct VectorDouble
 
+A plain 2D vector value, cheap to copy and pass by value. Everything which
+does not need a square root or trigonometry is constexpr.
+
 Constructors:
 
+    VectorDouble()
+        Creates the zero vector.
     VectorDouble(const double&, const double&)
         Creates a 2D vector with its components i and j, such that A<i,j>.
 
@@ -11,103 +16,91 @@ Public Methods:
     double operator* const(VectorDouble&)
         Returns the dot product of two VectorDoubles.
     VectorDouble operator+ const(VectorDouble&)
-        Returns the resultant vector of the addition of two VectorDoubles.
+    VectorDouble operator- const(VectorDouble&)
+        Return the sum or difference of two VectorDoubles.
+    VectorDouble scaled(const double&)
+        Returns the vector multiplied by the supplied scalar.
+    VectorDouble toStandard()
+        Returns the vector scaled such that its larger component is 1 in
+        magnitude (the zero vector stays zero).
+    VectorDouble normalized()
+        Returns the vector scaled to a magnitude of 1 (the zero vector stays
+        zero).
+    VectorDouble rotatedDeg(const double&)
+        Returns the vector rotated counterclockwise by the supplied degrees.
+        Rotating a field-oriented vector by a clockwise yaw gives it relative
+        to the robot.
+    double magnitudeSquared()
     double magnitude()
-        Returns the magnitude of the VectorDouble.
+        Return the (squared) magnitude of the VectorDouble.
     double unitCircleAngleDeg()
-        Returns the angle in degrees of the operated vector when inscribed in
-        standard position.
+        Returns the angle in degrees (0-360) of the operated vector when
+        inscribed in standard position.
 */
 
 #pragma once
 
 #include <math.h>
+#include <type_traits>
 
 struct VectorDouble {
 
-    VectorDouble(const double &iVal, const double &jVal) {
-
-        i = iVal;
-        j = jVal;
-    }
+    constexpr VectorDouble() : i(0), j(0) {}
+    constexpr VectorDouble(const double &iVal, const double &jVal) : i(iVal), j(jVal) {}
 
-    double operator* (VectorDouble const &otherVector) {
+    constexpr double operator* (VectorDouble const &otherVector) const {
 
         return ((i * otherVector.i) + (j * otherVector.j));
     }
-    VectorDouble operator+ (VectorDouble const &otherVector) {
+    constexpr VectorDouble operator+ (VectorDouble const &otherVector) const {
 
-        VectorDouble resultVector (i + otherVector.i, j + otherVector.j);
-        return resultVector;
+        return VectorDouble(i + otherVector.i, j + otherVector.j);
     }
+    constexpr VectorDouble operator- (VectorDouble const &otherVector) const {
 
-    VectorDouble* toStandard() {
-
-        VectorDouble* result = new VectorDouble(0, 0);
-        if (abs(i) >= abs(j)) {
-
-            result->i = 1.0;
-            result->j = j / i;
-        }
-        else {
-
-            result->i = i / j;
-            result->j = 1.0;
-        }
-        if (i < 0) result->i *= -1;
-        if (j < 0) result->j *= -1;
-
-        return result;
+        return VectorDouble(i - otherVector.i, j - otherVector.j);
     }
+    constexpr VectorDouble scaled(const double &scalar) const {
 
-    double magnitude() {
-
-        return sqrt(pow(i, 2) + pow(j, 2));
+        return VectorDouble(i * scalar, j * scalar);
     }
-    //TODO: Inline function documentation
-    double unitCircleAngleDeg() {
 
-        double calculatedAngle = 0;
+    constexpr VectorDouble toStandard() const {
 
-        //Quadrant I
-        if (i > 0 && j > 0) {
-
-            calculatedAngle = atan(j / i) * (180 / M_PI);
-        }
-        //Quadrant II
-        else if (i < 0 && j > 0) {
-
-            calculatedAngle = 180 - atan(j / -i) * (180 / M_PI);
-        }
-        //Quadrant III
-        else if (i < 0 && j < 0) {
+        double largest = (i < 0 ? -i : i) >= (j < 0 ? -j : j) ? (i < 0 ? -i : i) : (j < 0 ? -j : j);
+        return largest == 0 ? VectorDouble() : scaled(1 / largest);
+    }
+    VectorDouble normalized() const {
 
-            calculatedAngle = 180 + atan(-j / -i) * (180 / M_PI);
-        }
-        //Quadrant IV
-        else if (i > 0 && j < 0) {
+        double length = magnitude();
+        return length == 0 ? VectorDouble() : scaled(1 / length);
+    }
+    VectorDouble rotatedDeg(const double &degrees) const {
 
-            calculatedAngle = 360 - atan(-j / i) * (180 / M_PI);
-        }
-        else if (i == 0 && j > 0) {
+        double radians = degrees * (M_PI / 180);
+        double cosine = cos(radians);
+        double sine = sin(radians);
+        return VectorDouble(i * cosine - j * sine, i * sine + j * cosine);
+    }
 
-            calculatedAngle = 90;
-        }
-        else if (i == 0 && j < 0) {
+    constexpr double magnitudeSquared() const {
 
-            calculatedAngle = 270;
-        }
-        else if (i > 0 && j == 0) {
+        return i * i + j * j;
+    }
+    double magnitude() const {
 
-            calculatedAngle = 0;
-        }
-        else if (i < 0 && j == 0) {
+        return sqrt(magnitudeSquared());
+    }
+    double unitCircleAngleDeg() const {
 
-            calculatedAngle = 180;
-        }
-        return calculatedAngle;
+        //atan2 covers every quadrant and axis, returning -180 to 180 (and 0
+        //for the zero vector), so only the lower half needs to come around.
+        double calculatedAngle = atan2(j, i) * (180 / M_PI);
+        return calculatedAngle < 0 ? calculatedAngle + 360 : calculatedAngle;
     }
 
     double i;
     double j;
-};
\ No newline at end of file
+};
+
+static_assert(std::is_trivially_copyable<VectorDouble>::value, "VectorDouble must stay a plain value");
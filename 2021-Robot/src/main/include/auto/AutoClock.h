@@ -0,0 +1,79 @@
+#ifndef AUTOCLOCK_H
+#define AUTOCLOCK_H
+
+#include <frc/Timer.h>
+
+//The time, in seconds, that every time-dependent part of auto (and the
+//recorder) reads. By default this is the FPGA clock, which simulation also
+//steps while its timing is paused. Anything else, such as a desktop tool
+//running routines without a HAL, can Set() a SteppedClock instead and
+//advance it one loop at a time, so the same routine gives identical results
+//on every run, however fast it is run.
+class AutoClock {
+
+    public:
+        virtual ~AutoClock() {}
+
+        virtual double Now() = 0;
+
+        static AutoClock& Get() {
+
+            return *Current();
+        }
+
+        //Uses the supplied clock from now on, or the FPGA clock again if it is
+        //nullptr. The clock is not owned, and must outlive its use.
+        static void Set(AutoClock *clock) {
+
+            Current() = clock != nullptr ? clock : Default();
+        }
+
+    private:
+        static AutoClock*& Current() {
+
+            static AutoClock *current = Default();
+            return current;
+        }
+
+        static AutoClock* Default();
+};
+
+class FPGAClock : public AutoClock {
+
+    public:
+        double Now() {
+
+            return frc::Timer::GetFPGATimestamp();
+        }
+};
+
+//A clock which only moves when told to.
+class SteppedClock : public AutoClock {
+
+    public:
+        SteppedClock(const double &start = 0) {
+
+            m_now = start;
+        }
+
+        double Now() {
+
+            return m_now;
+        }
+
+        void Step(const double &seconds) {
+
+            m_now += seconds;
+        }
+
+    private:
+        double m_now;
+};
+
+inline AutoClock* AutoClock::Default() {
+
+    static FPGAClock clock;
+    return &clock;
+}
+
+#endif
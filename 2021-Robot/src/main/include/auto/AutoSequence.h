@@ -48,7 +48,7 @@ class AutoSequence : public AutoStep {
                         else {
 
                             // If we shouldn't loop, this AutoSequence is done
-                            m_done = false;
+                            m_done = true;
                         }
                     }
                     else {
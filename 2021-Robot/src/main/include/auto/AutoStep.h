@@ -11,6 +11,7 @@ class AutoStep {
 
             m_name = name;
         }
+        virtual ~AutoStep() {}
 
         virtual void Init() = 0;
         virtual bool Execute() = 0;
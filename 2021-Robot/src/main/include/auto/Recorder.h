@@ -8,21 +8,35 @@
 #include <string>
 #include <frc/smartdashboard/SmartDashboard.h>
 #include <frc/DriverStation.h>
+#include <frc/RobotBase.h>
+
+#include "auto/AutoClock.h"
+#include "auto/Recording.h"
+#include "DashboardPublisher.h"
+#include "RobotMap.h"
 
 class Recorder {
 
     public:
 
-        Recorder() {
+        Recorder(DashboardPublisher &publisher) : m_status(publisher, "Recorder::m_log", 0) {
 
             m_log.str("");
             m_log.clear();
             m_counter = 0;
+            m_startTime = 0;
         }
 
-        void Record(const double x, const double y, const double z, const bool precision) {
+        //While limelightLock is held, playback turns Zion toward the target
+        //rather than following the recorded z.
+        void Record(const double x, const double y, const double z, const bool precision, const bool limelightLock = false) {
+
+            if (m_counter == 0) {
 
-            m_log << std::setprecision(R_zionAutoControllerRecorderPrecision) << std::fixed << x + 1 << y + 1 << z + 1;// << (precision ? 1 : 0) << (limelightLock ? 1 : 0);
+                m_log << Recording::kLockChannelTag;
+                m_startTime = AutoClock::Get().Now();
+            }
+            m_log << std::setprecision(R_zionAutoControllerRecorderPrecision) << std::fixed << x + 1 << y + 1 << z + 1 << (limelightLock ? 1.0 : 0.0) + 1;// << (precision ? 1 : 0);
             SetStatus("Recording in progress...");
             m_counter++;
         }
@@ -34,13 +48,13 @@ class Recorder {
                 
                 SetStatus(newStr);
                 std::string outputString = frc::SmartDashboard::GetString("Recorder::output_file_string", "unknown");
-                std::string fullPath = "/u/" + outputString;
+                std::string fullPath = GetDirectory() + outputString;
                 std::string logAsStr = m_log.str() + "x";
                 std::ofstream myFile(fullPath, std::ios::out | std::ios::trunc);
                 //myFile.flush();
                 if (myFile.is_open()) {
                 
-                    frc::DriverStation::ReportError("About to write "/*the following to \"" + fullPath + "\": " + logAsStr + " with "*/ + std::to_string(m_counter) + " updates");
+                    frc::DriverStation::ReportError("About to write "/*the following to \"" + fullPath + "\": " + logAsStr + " with "*/ + std::to_string(m_counter) + " updates over " + std::to_string(AutoClock::Get().Now() - m_startTime) + " seconds");
                     myFile << logAsStr;
                     myFile.close();
                 }
@@ -57,12 +71,21 @@ class Recorder {
 
         void SetStatus(std::string status) {
 
-            frc::SmartDashboard::PutString("Recorder::m_log", status);
+            m_status.set(status);
+        }
+
+        //Recordings live on the USB stick, or in R_simRecordingDirectory
+        //when simulated on a desktop.
+        static std::string GetDirectory() {
+
+            return frc::RobotBase::IsSimulation() ? R_simRecordingDirectory : "/u/";
         }
 
     private:
         std::stringstream m_log;
         int m_counter;
+        double m_startTime;
+        DashboardString m_status;
 };
 
 #endif
\ No newline at end of file
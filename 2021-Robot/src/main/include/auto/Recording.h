@@ -0,0 +1,97 @@
+#ifndef RECORDING_H
+#define RECORDING_H
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "RobotMap.h"
+
+//The format Recorder writes and RunPrerecorded plays: one controller state
+//per loop, each value offset by one and written in R_zionAutoControllerTotalDigits
+//characters, ending with an 'x'. Recordings beginning with kLockChannelTag
+//have a fourth value per state, 1 where the Limelight lock was held (offset
+//by one like the rest); older recordings have three and never lock. Kept
+//free of WPILib so desktop tools can read recordings too.
+class Recording {
+
+    public:
+        static const char kLockChannelTag = 'L';
+
+        struct ControllerState {
+
+            double x;
+            double y;
+            double z;
+            bool precision;
+            bool limelightLock;
+        };
+
+        //Reads a recording into the supplied vector. Returns an empty string
+        //on success, or why it failed.
+        static std::string Parse(const std::string &stringValues, std::vector<ControllerState> &values) {
+
+            bool hasLockChannel = !stringValues.empty() && stringValues.at(0) == kLockChannelTag;
+            int start = hasLockChannel ? 1 : 0;
+            int stateLength = R_zionAutoControllerTotalDigits * (hasLockChannel ? 4 : 3);
+            if ((int)stringValues.length() < start + stateLength) {
+
+                return "Not enough data";
+            }
+            if (stringValues.at(stringValues.length() - 1) != 'x') {
+
+                return "Could not find EOF in recorded values";
+            }
+            //A recording cut short (such as by the USB stick being pulled
+            //mid-write) ends partway through a state.
+            if (((int)stringValues.length() - start - 1) % stateLength != 0) {
+
+                return "Recorded values end partway through a state";
+            }
+            //Nothing is kept unless all of it parses, so a failed recording
+            //is never played in part.
+            std::vector<ControllerState> parsed;
+            int states = ((int)stringValues.length() - start - 1) / stateLength;
+            for (int pos = 0; pos < states; ++pos) {
+
+                int offset = start + pos * stateLength;
+                ControllerState tempState;
+                try {
+
+                    tempState.x =               std::stod(stringValues.substr(offset, R_zionAutoControllerTotalDigits)) - 1;
+                    tempState.y =               std::stod(stringValues.substr(offset + R_zionAutoControllerTotalDigits, R_zionAutoControllerTotalDigits)) - 1;
+                    tempState.z =               std::stod(stringValues.substr(offset + R_zionAutoControllerTotalDigits * 2, R_zionAutoControllerTotalDigits)) - 1;
+                    tempState.precision =       false;
+                    tempState.limelightLock =   hasLockChannel && std::stod(stringValues.substr(offset + R_zionAutoControllerTotalDigits * 3, R_zionAutoControllerTotalDigits)) - 1 > .5;
+                }
+                catch (const std::logic_error&) {
+
+                    return "Could not read recorded state " + std::to_string(pos);
+                }
+                parsed.push_back(tempState);
+            }
+            if (parsed.empty()) {
+
+                return "File parsed was empty...?";
+            }
+            values.insert(values.end(), parsed.begin(), parsed.end());
+            return "";
+        }
+
+        //The same, from the file at the supplied path.
+        static std::string Load(const std::string &path, std::vector<ControllerState> &values) {
+
+            std::ifstream valuesFile(path);
+            if (!valuesFile.is_open()) {
+
+                return "Unable to open values file";
+            }
+            std::ostringstream oss;
+            oss << valuesFile.rdbuf();
+            return Parse(oss.str(), values);
+        }
+};
+
+#endif
@@ -3,32 +3,48 @@
 
 #include "auto/AutoStep.h"
 #include "Launcher.h"
+#include "LauncherModel.h"
 #include "Limelight.h"
+#include "RobotMap.h"
+#include "ShotCompensator.h"
 
 class AimLauncher : public AutoStep {
 
     public:
-        AimLauncher(Launcher &refLauncher, Limelight &refLimelight) : AutoStep("AimLauncher") {
+        //If a ShotCompensator is supplied, aims for the point which leads the
+        //target by Zion's velocity, and scales the launch speed to reach it
+        //where the hood alone cannot.
+        AimLauncher(Launcher &refLauncher, Limelight &refLimelight, ShotCompensator *compensator = nullptr, const double launchSpeed = R_launcherDefaultSpeed) : AutoStep("AimLauncher") {
 
             m_launcher = &refLauncher;
             m_limelight = &refLimelight;
+            m_compensator = compensator;
+            m_launchSpeed = launchSpeed;
         }
 
         void Init() {}
 
         bool Execute() {
 
-            double area = m_limelight->getTargetArea();
-            double servoPosition = -812.644 * pow(area, 6) + 7108.25 * pow(area, 5) - 24539.6 * pow(area, 4) + 41879.3 * pow(area, 3) - 35627.7 * pow(area, 2) + 12700.6 * area -679.787;
-            //frc::SmartDashboard::PutNumber("RAW SERVO POSITION", m_servoSpeed);
-            servoPosition = (servoPosition < 0 || servoPosition > 180) ? (servoPosition < 0 ? 0 : 180) : servoPosition;
-            m_launcher->setServo(Launcher::kSetAngle, servoPosition);
+            if (m_compensator) {
+
+                ShotCompensator::Solution solution = m_compensator->solve();
+                m_launcher->setServo(Launcher::kSetAngle, solution.launcher.servo);
+                m_launcher->setLaunchSpeed(m_launchSpeed * solution.launchScale);
+            }
+            else {
+
+                double servoPosition = LauncherModel::solve(m_limelight->getTargetArea()).servo;
+                m_launcher->setServo(Launcher::kSetAngle, servoPosition);
+            }
             return true;
         }
 
     private:
         Launcher* m_launcher;
         Limelight* m_limelight;
+        ShotCompensator* m_compensator;
+        double m_launchSpeed;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -15,14 +15,14 @@ class AssumeDirectionAbsolute : public AutoStep {
             m_zion = &refZion;
             switch (directionToMove) {
 
-                case SwerveTrain::ZionDirections::kForward: m_targetVector = new VectorDouble(0, 1); break;
-                case SwerveTrain::ZionDirections::kRight: m_targetVector = new VectorDouble(1, 0); break;
-                case SwerveTrain::ZionDirections::kBackward: m_targetVector = new VectorDouble(0, -1); break;
-                case SwerveTrain::ZionDirections::kLeft: m_targetVector = new VectorDouble(-1, 0); break;
+                case SwerveTrain::ZionDirections::kForward: m_targetVector = VectorDouble(0, 1); break;
+                case SwerveTrain::ZionDirections::kRight: m_targetVector = VectorDouble(1, 0); break;
+                case SwerveTrain::ZionDirections::kBackward: m_targetVector = VectorDouble(0, -1); break;
+                case SwerveTrain::ZionDirections::kLeft: m_targetVector = VectorDouble(-1, 0); break;
             }
         }
 
-        AssumeDirectionAbsolute(SwerveTrain &refZion, VectorDouble* vectorToGoTo) : AutoStep("AssumeDirectionAbsolute") {
+        AssumeDirectionAbsolute(SwerveTrain &refZion, const VectorDouble &vectorToGoTo) : AutoStep("AssumeDirectionAbsolute") {
 
             m_zion = &refZion;
             m_targetVector = vectorToGoTo;
@@ -32,12 +32,12 @@ class AssumeDirectionAbsolute : public AutoStep {
 
         bool Execute() {
 
-            return m_zion->SetZionMotorsToVector(*m_targetVector);
+            return m_zion->SetZionMotorsToVector(m_targetVector);
         }
 
     private:
         SwerveTrain* m_zion;
-        VectorDouble* m_targetVector;
+        VectorDouble m_targetVector;
 };
 
 #endif
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include <string>
 
+#include "SensorSampler.h"
+#include "SwerveKinematics.h"
 #include "SwerveTrain.h"
 #include "VectorDouble.h"
 #include "RobotMap.h"
@@ -10,23 +12,25 @@
 class AssumeDistance : public AutoStep {
 
     public:
-        AssumeDistance(SwerveTrain &refZion, const double& distanceToAssume, const int &directionToMove) : AutoStep("AssumeDistance") {
+        AssumeDistance(SwerveTrain &refZion, SensorSampler &refSensors, const double& distanceToAssume, const int &directionToMove) : AutoStep("AssumeDistance") {
 
             m_zion = &refZion;
+            m_sensors = &refSensors;
             m_targetDistance = distanceToAssume;
             switch (directionToMove) {
 
-                case SwerveTrain::ZionDirections::kForward: m_direction = new VectorDouble(0, 1); break;
-                case SwerveTrain::ZionDirections::kRight: m_direction = new VectorDouble(1, 0); break;
-                case SwerveTrain::ZionDirections::kBackward: m_direction = new VectorDouble(0, -1); break;
-                case SwerveTrain::ZionDirections::kLeft: m_direction = new VectorDouble(-1, 0); break;
+                case SwerveTrain::ZionDirections::kForward: m_direction = VectorDouble(0, 1); break;
+                case SwerveTrain::ZionDirections::kRight: m_direction = VectorDouble(1, 0); break;
+                case SwerveTrain::ZionDirections::kBackward: m_direction = VectorDouble(0, -1); break;
+                case SwerveTrain::ZionDirections::kLeft: m_direction = VectorDouble(-1, 0); break;
             }
         }
-        AssumeDistance(SwerveTrain &refZion, const double& distanceToAssume, VectorDouble* vectorToGoTo) : AutoStep("AssumeDistance") {
+        AssumeDistance(SwerveTrain &refZion, SensorSampler &refSensors, const double& distanceToAssume, const VectorDouble &vectorToGoTo) : AutoStep("AssumeDistance") {
 
             m_zion = &refZion;
+            m_sensors = &refSensors;
             m_targetDistance = distanceToAssume;
-            m_direction = vectorToGoTo->toStandard();
+            m_direction = vectorToGoTo.toStandard();
         }
 
         void Init() {
@@ -35,7 +39,7 @@ class AssumeDistance : public AutoStep {
             //memory for comparison once operating (since we're translating
             //in a lateral direction, we only have to care about one encoder
             //value)...
-            mInitialFrontRightDrivePosition = m_zion->m_frontRight->GetDrivePosition();
+            mInitialFrontRightDrivePosition = m_sensors->getFrame().drivePositions[SwerveKinematics::kFrontRight];
             //Calculate the end goal encoder value with circumference and the
             //known amount of encoder values per rotation...
             m_targetEncoderPosition = mInitialFrontRightDrivePosition + (m_targetDistance * R_kuhnsConstant) / R_circumfrenceWheel;
@@ -46,10 +50,10 @@ class AssumeDistance : public AutoStep {
             //If we're not in tolerance for meeting the goal value (since
             //going to a distance generates no oscillation, zero can be
             //used as a tolerance)...
-            double delta = m_targetEncoderPosition - m_zion->m_frontRight->GetDrivePosition();
+            double delta = m_targetEncoderPosition - m_sensors->getFrame().drivePositions[SwerveKinematics::kFrontRight];
             if (abs(delta) > R_kuhnsConstant * .1) {
 
-                m_zion->Drive(m_direction->i, m_direction->j, 0, false, false, false);
+                m_zion->Drive(m_direction.i, m_direction.j, 0, false, false, false);
                 //If we made it to here, we didn't succeed, so return false for
                 //another go at it.
                 return false;
@@ -66,10 +70,11 @@ class AssumeDistance : public AutoStep {
 
     private:
         SwerveTrain* m_zion;
+        SensorSampler* m_sensors;
         double mInitialFrontRightDrivePosition;
         double m_targetEncoderPosition;
         double m_targetDistance;
-        VectorDouble *m_direction;
+        VectorDouble m_direction;
 };
 
 #endif
\ No newline at end of file
@@ -2,29 +2,35 @@
 #define LIMELIGHTLOCK_H
 
 #include "auto/AutoStep.h"
+#include "Limelight.h"
+#include "ShotCompensator.h"
 #include "SwerveTrain.h"
-#include "LimelightLock.h"
 
 class LimelightLock : public AutoStep {
 
     public:
-        LimelightLock(SwerveTrain &refZion, Limelight &refLime) : AutoStep("LimelightLock") {
+        //If a ShotCompensator is supplied, locks on to the point which leads
+        //the target by Zion's velocity rather than on to the target itself.
+        LimelightLock(SwerveTrain &refZion, Limelight &refLime, ShotCompensator *compensator = nullptr) : AutoStep("LimelightLock") {
 
             m_zion = &refZion;
             m_limelight = &refLime;
+            m_compensator = compensator;
         }
 
         void Init() {}
 
         bool Execute() {
 
-            m_zion->Drive(0, 0, m_limelight->CalculateLimelightLockSpeed(), false, false, false);
-            return m_limelight->isWithinHorizontalTolerance();
+            double offset = m_compensator ? m_compensator->solve().offset : m_limelight->getHorizontalOffset();
+            m_zion->Drive(0, 0, m_limelight->CalculateLimelightLockSpeed(offset), false, false, false);
+            return m_limelight->isWithinHorizontalTolerance(offset);
         }
 
     private:
         SwerveTrain* m_zion;
         Limelight* m_limelight;
+        ShotCompensator* m_compensator;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,82 @@
+#ifndef RUNGALACTICSEARCH_H
+#define RUNGALACTICSEARCH_H
+
+#include <string>
+
+#include "auto/AutoClock.h"
+#include "auto/AutoStep.h"
+#include "auto/steps/RunPrerecorded.h"
+#include "GalacticSearch.h"
+#include "Limelight.h"
+#include "RobotMap.h"
+#include "SwerveTrain.h"
+
+//Plays the preloaded recording of whichever Galactic Search layout the
+//Limelight sees. If it was not already seen while disabled, keeps looking
+//for up to R_galacticSearchTimeout, then gives up and stays put.
+class RunGalacticSearch : public AutoStep {
+
+    public:
+        RunGalacticSearch(SwerveTrain &refZion, Limelight &refLimelight, GalacticSearch &refSearch) : AutoStep("RunGalacticSearch") {
+
+            m_zion = &refZion;
+            m_limelight = &refLimelight;
+            m_search = &refSearch;
+            m_run = nullptr;
+        }
+        ~RunGalacticSearch() {
+
+            delete m_run;
+        }
+
+        void Init() {
+
+            delete m_run;
+            m_run = nullptr;
+            m_startTime = AutoClock::Get().Now();
+            m_search->start();
+            dispatch();
+        }
+
+        bool Execute() {
+
+            if (m_run == nullptr) {
+
+                dispatch();
+            }
+            if (m_run == nullptr) {
+
+                if (AutoClock::Get().Now() - m_startTime > R_galacticSearchTimeout) {
+
+                    m_search->stop();
+                    m_zion->Stop();
+                    Log("Galactic Search: no layout seen after " + std::to_string(R_galacticSearchTimeout) + " seconds");
+                    return true;
+                }
+                return false;
+            }
+            return m_run->Execute();
+        }
+
+    private:
+        //Starts the recording of the layout, if it is known.
+        void dispatch() {
+
+            if (!m_search->update()) {
+
+                return;
+            }
+            m_search->stop();
+            int path = m_search->getPath();
+            m_run = new RunPrerecorded(*m_zion, *m_limelight, GalacticSearch::GetName(path), m_search->getRecording(path));
+            m_run->Init();
+        }
+
+        SwerveTrain* m_zion;
+        Limelight* m_limelight;
+        GalacticSearch* m_search;
+        RunPrerecorded* m_run;
+        double m_startTime;
+};
+
+#endif
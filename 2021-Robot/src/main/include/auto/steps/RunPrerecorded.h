@@ -4,85 +4,59 @@
 #include <iostream>
 #include <string>
 #include <frc/smartdashboard/SmartDashboard.h>
-#include <fstream>
-#include <sstream>
 #include <frc/DriverStation.h>
 
 #include "SwerveTrain.h"
 #include "RobotMap.h"
 #include "Limelight.h"
+#include "ShotCompensator.h"
+#include "auto/Recorder.h"
+#include "auto/Recording.h"
 
 class RunPrerecorded : public AutoStep {
 
 public:
-    RunPrerecorded(SwerveTrain& refZion, Limelight &limeToSet, std::string pathToValues) : AutoStep("PreRecorded") {
+    //If a ShotCompensator is supplied, locking on (see Execute) uses its
+    //offset, as LimelightLock does, rather than the raw tx.
+    RunPrerecorded(SwerveTrain& refZion, Limelight &limeToSet, std::string pathToValues, ShotCompensator *compensator = nullptr) : AutoStep("PreRecorded") {
 
         m_zion = &refZion;
         m_path = pathToValues;
         m_limelight = &limeToSet;
+        m_compensator = compensator;
+        m_preloaded = false;
+    }
+    //Plays a recording already read, such as one GalacticSearch preloaded,
+    //so that nothing is read from the USB stick when it begins.
+    RunPrerecorded(SwerveTrain& refZion, Limelight &limeToSet, std::string name, const std::vector<Recording::ControllerState> &values, ShotCompensator *compensator = nullptr) : AutoStep("PreRecorded") {
+
+        m_zion = &refZion;
+        m_path = name;
+        m_limelight = &limeToSet;
+        m_compensator = compensator;
+        m_values = values;
+        m_preloaded = true;
     }
 
     void Init() {
 
-        m_values.clear();
-        std::ifstream valuesFile("/u/" + m_path);
-        if (valuesFile.is_open()) {
-            
-            std::ostringstream oss;
-            oss.str("");
-            oss.clear();
-            oss << valuesFile.rdbuf();
-            std::string stringValues = oss.str();
-           // _Log(stringValues);
-            if (stringValues.length() >= R_zionAutoControllerTotalDigits * 3) {
-                
-                if (stringValues.at(stringValues.length() - 1) == 'x') {
-
-                    bool done = false;
-                    int pos = 0;
-                    while (!done) {
-
-                        if (stringValues.at(pos * (R_zionAutoControllerTotalDigits * 3)) == 'x') {
-
-                            done = true;
-                        }
-                        else {
-
-                            ControllerState tempState;
-                            tempState.x =               std::stod(stringValues.substr(pos * (R_zionAutoControllerTotalDigits * 3), R_zionAutoControllerTotalDigits)) - 1;
-                            tempState.y =               std::stod(stringValues.substr(pos * (R_zionAutoControllerTotalDigits * 3) + R_zionAutoControllerTotalDigits, R_zionAutoControllerTotalDigits)) - 1;
-                            tempState.z =               std::stod(stringValues.substr(pos * (R_zionAutoControllerTotalDigits * 3) + R_zionAutoControllerTotalDigits * 2, R_zionAutoControllerTotalDigits)) - 1;
-                            /*tempState.precision =       std::stod(stringValues.substr(pos * (R_zionAutoControllerTotalDigits * 5) + R_zionAutoControllerTotalDigits * 3, R_zionAutoControllerTotalDigits)) == 1.0;
-                            tempState.limelightLock =   std::stod(stringValues.substr(pos * (R_zionAutoControllerTotalDigits * 5) + R_zionAutoControllerTotalDigits * 4, R_zionAutoControllerTotalDigits)) == 1.0;*/
-                            m_values.push_back(tempState);
-                            pos++;
-                        }
-                    }
-                    if (!m_values.empty()) {
-
-                        m_currentValue = m_values.begin();
-                        m_endValue = m_values.end();
-                        _Log("File successfully parsed! The run should take " + std::to_string(m_values.size() / 50.0) + " seconds");
-                        _Log("Vector has " + std::to_string(m_values.size()) + " ControllerState elements");
-                    }
-                    else {
-
-                        _Log("File parsed was empty...?");
-                    }
-                }
-                else {
+        std::string error = m_values.empty() ? "There was no preloaded data" : "";
+        if (!m_preloaded) {
 
-                    _Log("Could not find EOF in recorded values");
-                }
-            }
-            else {
+            m_values.clear();
+            error = Recording::Load(Recorder::GetDirectory() + m_path, m_values);
+        }
+        m_finished = false;
+        if (error.empty()) {
 
-                _Log("Not enough data");                
-            }
+            m_currentValue = m_values.begin();
+            m_endValue = m_values.end();
+            _Log("File successfully parsed! The run should take " + std::to_string(m_values.size() / 50.0) + " seconds");
+            _Log("Vector has " + std::to_string(m_values.size()) + " ControllerState elements");
         }
         else {
 
-            _Log("Unable to open values file");
+            _Log(error);
         }
     }
 
@@ -93,8 +67,13 @@ public:
             // If we are at the end of the file
             if (m_currentValue == m_endValue) {
 
-                m_zion->Stop();
-                _Log("Finished executing recording");
+                //Run alongside other steps, this is called again once done.
+                if (!m_finished) {
+
+                    m_zion->Stop();
+                    _Log("Finished executing recording");
+                    m_finished = true;
+                }
                 return true;
             }
             else {
@@ -102,8 +81,15 @@ public:
                 double x = m_currentValue->x;
                 double y = m_currentValue->y;
                 double z = m_currentValue->z;
-                /*bool precision = m_currentValue->precision;
-                bool limelightLock = m_currentValue->limelightLock;*/
+                //Where the recording was locked on to the target, lock on
+                //now instead of repeating the recorded turn, so that Zion
+                //arrives aimed wherever it actually ends up.
+                if (m_currentValue->limelightLock) {
+
+                    double offset = m_compensator ? m_compensator->solve().offset : m_limelight->getHorizontalOffset();
+                    z = m_limelight->CalculateLimelightLockSpeed(offset);
+                }
+                /*bool precision = m_currentValue->precision;*/
                 m_zion->Drive(x, y, z, false, false, false);
                 m_currentValue++;
                 return false;
@@ -111,8 +97,12 @@ public:
         }
         else {
 
-            m_zion->Stop();
-            _Log("Finished executing recording; there was no data");
+            if (!m_finished) {
+
+                m_zion->Stop();
+                _Log("Finished executing recording; there was no data");
+                m_finished = true;
+            }
             return true;
         }
     }
@@ -122,14 +112,7 @@ public:
         Log("[" + m_path + "] " + message);
     }
 
-    struct ControllerState {
-
-        double x;
-        double y;
-        double z;
-        bool precision;
-        bool limelightLock;
-    };
+    typedef Recording::ControllerState ControllerState;
 
 private:
     SwerveTrain* m_zion;
@@ -137,7 +120,10 @@ private:
     std::vector<ControllerState>::iterator m_currentValue;
     std::vector<ControllerState>::iterator m_endValue;
     std::string m_path;
+    bool m_preloaded;
+    bool m_finished;
     Limelight* m_limelight;
+    ShotCompensator* m_compensator;
 };
 
 #endif
\ No newline at end of file
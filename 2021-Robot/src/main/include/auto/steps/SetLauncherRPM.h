@@ -1,6 +1,8 @@
 #ifndef SETLAUNCHERRPM_H
 #define SETLAUNCHERRPM_H
 
+#include "auto/AutoClock.h"
+#include "auto/AutoStep.h"
 #include "Launcher.h"
 #include "RobotMap.h"
 
@@ -17,6 +19,7 @@ class SetLauncherRPM : public AutoStep {
         void Init() {
 
             m_launcher->setLaunchSpeed(m_rpm);
+            m_initialTime = AutoClock::Get().Now();
         }
 
         bool Execute() {
@@ -27,8 +30,9 @@ class SetLauncherRPM : public AutoStep {
             }
             else {
 
-                frc::Wait(7);
-                return true;
+                //Give the flywheel time to spool up without holding up the
+                //rest of the loop.
+                return AutoClock::Get().Now() - m_initialTime >= R_launcherSpoolUpTime;
                 //return abs(m_launcher->GetRPM() - m_rpm) <= R_launcherSetRPMTolerance;
             }
         }
@@ -37,6 +41,7 @@ class SetLauncherRPM : public AutoStep {
         Launcher* m_launcher;
         bool m_async;
         double m_rpm;
+        double m_initialTime;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,138 @@
+#ifndef SHOOTSEQUENCE_H
+#define SHOOTSEQUENCE_H
+
+#include <string>
+
+#include "auto/AutoClock.h"
+#include "auto/AutoStep.h"
+#include "BallCounter.h"
+#include "Launcher.h"
+#include "RobotMap.h"
+
+//Feeds Power Cells into a spun-up launcher one at a time, each as soon as the
+//flywheel has recovered from the last. A launch is detected by the dip in
+//flywheel RPM. Finishes once the requested number of shots has been taken,
+//but no more than the ball counter held when it began, so that the last
+//Power Cell is launched rather than left in the index. The magazine is also
+//considered empty when the index runs unloaded (or feeds for too long
+//without a launch), which corrects the counter to 0.
+class ShootSequence : public AutoStep {
+
+    public:
+        ShootSequence(Launcher &refLauncher, BallCounter &refBallCounter, const double indexSpeed, const int shotsToTake = R_launcherMagazineCapacity) : AutoStep("ShootSequence") {
+
+            m_launcher = &refLauncher;
+            m_ballCounter = &refBallCounter;
+            m_indexSpeed = indexSpeed;
+            m_shotsRequested = shotsToTake;
+        }
+
+        void Init() {
+
+            //The launcher should already be spun up, so whatever it is doing
+            //now is what it should recover to after every shot.
+            m_settledRPM = m_launcher->getLaunchRPM();
+            m_shotsTaken = 0;
+            //With nothing counted (or a wrong count), fall back to the
+            //empty checks.
+            int count = m_ballCounter->getCount();
+            m_shotsToTake = count > 0 && count < m_shotsRequested ? count : m_shotsRequested;
+            m_initialTime = AutoClock::Get().Now();
+            EnterState(State::kWaitForRecovery);
+        }
+
+        bool Execute() {
+
+            double now = AutoClock::Get().Now();
+            double rpm = m_launcher->getLaunchRPM();
+
+            switch (m_state) {
+
+                case State::kWaitForRecovery:
+                    if (rpm >= m_settledRPM - R_launcherShootRecoveredToleranceRPM) {
+
+                        //Track the settled speed upward so that a slow
+                        //spool-up does not leave the reference too low.
+                        if (rpm > m_settledRPM) {
+
+                            m_settledRPM = rpm;
+                        }
+                        EnterState(State::kFeeding);
+                    }
+                    else if (now - m_stateTime > R_launcherShootRecoveryTimeout) {
+
+                        //The flywheel settled somewhere lower than before
+                        //(usually battery sag), so take that as the reference.
+                        m_settledRPM = rpm;
+                        EnterState(State::kFeeding);
+                    }
+                    break;
+
+                case State::kFeeding:
+                    if (rpm < m_settledRPM - R_launcherShootDipRPM) {
+
+                        m_shotsTaken++;
+                        Log("Shot " + std::to_string(m_shotsTaken) + " launched at " + std::to_string(now - m_initialTime) + " seconds");
+                        if (m_shotsTaken >= m_shotsToTake) {
+
+                            return Finish(now);
+                        }
+                        EnterState(State::kWaitForRecovery);
+                        break;
+                    }
+                    if (m_launcher->getIndexCurrent() >= R_launcherShootIndexLoadedCurrent) {
+
+                        m_lastLoadedTime = now;
+                    }
+                    if (now - m_lastLoadedTime > R_launcherShootEmptyTime || now - m_stateTime > R_launcherShootFeedTimeout) {
+
+                        m_ballCounter->setCount(0);
+                        return Finish(now);
+                    }
+                    break;
+
+                case State::kDone:
+                    return true;
+            }
+            return false;
+        }
+
+    private:
+        enum class State {
+
+            kWaitForRecovery,
+            kFeeding,
+            kDone
+        };
+
+        void EnterState(const State state) {
+
+            m_state = state;
+            m_stateTime = AutoClock::Get().Now();
+            m_lastLoadedTime = m_stateTime;
+            //Only run the index while feeding, so nothing reaches the flywheel
+            //before it has recovered.
+            m_launcher->setIndexSpeed(state == State::kFeeding ? m_indexSpeed : 0);
+        }
+
+        bool Finish(const double now) {
+
+            EnterState(State::kDone);
+            Log("Launched " + std::to_string(m_shotsTaken) + " Power Cells in " + std::to_string(now - m_initialTime) + " seconds");
+            return true;
+        }
+
+        Launcher* m_launcher;
+        BallCounter* m_ballCounter;
+        double m_indexSpeed;
+        int m_shotsRequested;
+        int m_shotsToTake;
+        int m_shotsTaken;
+        State m_state;
+        double m_settledRPM;
+        double m_initialTime;
+        double m_stateTime;
+        double m_lastLoadedTime;
+};
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef WAITSECONDS_H
 #define WAITSECONDS_H
 
+#include "auto/AutoClock.h"
 #include "auto/AutoStep.h"
 
 class WaitSeconds : public AutoStep {
@@ -13,12 +14,12 @@ class WaitSeconds : public AutoStep {
 
         void Init() {
 
-            m_initialTime = frc::GetTime();
+            m_initialTime = AutoClock::Get().Now();
         }
 
         bool Execute() {
 
-            return frc::GetTime() - m_initialTime >= m_secondsToWait;
+            return AutoClock::Get().Now() - m_initialTime >= m_secondsToWait;
         }
 
     private:
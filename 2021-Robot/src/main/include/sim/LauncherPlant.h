@@ -0,0 +1,113 @@
+/*
+class LauncherPlant
+
+Constructors
+
+    LauncherPlant()
+        Creates a model of the launcher with a stopped flywheel and a full
+        magazine.
+
+Public Methods
+
+    void setOutputs(const double&, const double&)
+        Sets the percent output of the flywheel then the index, as their
+        SPARK MAXes would apply it.
+    void update(const double&, const double& = 1)
+        Advances the model by the supplied number of seconds, with the
+        supplied fraction of full battery voltage available.
+    void reset(const int& = R_launcherMagazineCapacity)
+        Stops the flywheel and loads the supplied number of Power Cells.
+
+    double getFlywheelRPM()
+        Returns the flywheel's speed in RPM, signed like its output.
+    double getIndexCurrent()
+        Returns the index motor's current in amps, which rises while it is
+        pushing a Power Cell.
+    int getPowerCells()
+        Returns how many Power Cells are left in the magazine.
+    int getLaunched()
+        Returns how many Power Cells have been launched since reset.
+
+The flywheel approaches its output's share of R_simFlywheelFreeRPM with a
+first-order lag. Each Power Cell takes R_simIndexFeedTime of index running
+to reach the flywheel, which then loses R_simShotDipRPM launching it.
+*/
+
+#pragma once
+
+#include <math.h>
+
+#include "RobotMap.h"
+
+class LauncherPlant {
+
+    public:
+        LauncherPlant() {
+
+            reset();
+        }
+
+        void setOutputs(const double &flywheel, const double &index) {
+
+            m_flywheelOutput = flywheel;
+            m_indexOutput = index;
+        }
+
+        void update(const double &dt, const double &voltageScale = 1) {
+
+            double target = m_flywheelOutput * voltageScale * R_simFlywheelFreeRPM;
+            m_flywheelRPM += (target - m_flywheelRPM) * (1 - exp(-dt / R_simFlywheelTimeConstant));
+
+            if (m_powerCells > 0 && fabs(m_indexOutput) > .05) {
+
+                m_feedProgress += dt * fabs(m_indexOutput);
+                if (m_feedProgress >= R_simIndexFeedTime) {
+
+                    //The flywheel gives up speed to the Power Cell.
+                    m_flywheelRPM -= copysign(R_simShotDipRPM, m_flywheelRPM);
+                    m_powerCells--;
+                    m_launched++;
+                    m_feedProgress = 0;
+                }
+            }
+        }
+
+        void reset(const int &powerCells = R_launcherMagazineCapacity) {
+
+            m_flywheelOutput = 0;
+            m_indexOutput = 0;
+            m_flywheelRPM = 0;
+            m_feedProgress = 0;
+            m_powerCells = powerCells;
+            m_launched = 0;
+        }
+
+        double getFlywheelRPM() {
+
+            return m_flywheelRPM;
+        }
+        double getIndexCurrent() {
+
+            if (fabs(m_indexOutput) <= .05) {
+
+                return 0;
+            }
+            return m_powerCells > 0 ? R_simIndexLoadedCurrent : R_simIndexFreeCurrent;
+        }
+        int getPowerCells() {
+
+            return m_powerCells;
+        }
+        int getLaunched() {
+
+            return m_launched;
+        }
+
+    private:
+        double m_flywheelOutput;
+        double m_indexOutput;
+        double m_flywheelRPM;
+        double m_feedProgress;
+        int m_powerCells;
+        int m_launched;
+};
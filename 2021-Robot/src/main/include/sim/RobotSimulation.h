@@ -0,0 +1,248 @@
+/*
+class RobotSimulation
+
+Constructors
+
+    RobotSimulation()
+        Creates the plant models. Nothing is connected to the simulated
+        hardware until init().
+
+Public Methods
+
+    void init()
+        Finds the simulated SPARK MAXes and NavX. Call from SimulationInit,
+        once every device has been constructed.
+    void update(const double&)
+        Reads every motor output, advances the plants by the supplied number
+        of seconds, and writes back what the sensors would read: encoder
+        positions and velocities, index current, NavX yaw, and the Limelight
+        target for the power port at R_simTargetPosition.
+    int runHeadlessAuto(Robot&, const std::string&)
+        Runs autonomous to completion (or R_simAutoTimeout) in simulated
+        time, as fast as the desktop allows, and prints a report: whether it
+        finished and how long it took, where Zion ended up, how many Power
+        Cells were launched, and, if the supplied recording name is not
+        empty, how far Zion strayed from the ideal path of that recording.
+        Returns a process exit code: 0 if autonomous finished.
+    SwervePlant& getSwerve()
+    LauncherPlant& getLauncher()
+        Returns the plants, for inspection.
+
+Devices are found by the names the vendor libraries give their simulated
+devices: "SPARK MAX [<CAN ID>]" from REV and "navX-Sensor[<port>]" from
+Kauai Labs. The ideal path of a recording is the same commands played
+through a plant with instant modules, starting with autonomous. Headless
+runs drive AutoClock with a SteppedClock, so they repeat exactly.
+*/
+
+#pragma once
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <frc/simulation/DriverStationSim.h>
+#include <frc/simulation/SimDeviceSim.h>
+#include <frc/simulation/SimHooks.h>
+#include <frc/SPI.h>
+#include <hal/SimDevice.h>
+#include <networktables/NetworkTable.h>
+#include <networktables/NetworkTableInstance.h>
+#include <units/time.h>
+
+#include "auto/AutoClock.h"
+#include "auto/Recorder.h"
+#include "auto/Recording.h"
+#include "Robot.h"
+#include "RobotMap.h"
+#include "sim/LauncherPlant.h"
+#include "sim/SwervePlant.h"
+#include "SwerveKinematics.h"
+
+class RobotSimulation {
+
+    public:
+        RobotSimulation() {
+
+            m_connected = false;
+        }
+
+        void init() {
+
+            const int driveIDs[4] = {R_CANIDZionFrontRightDrive, R_CANIDZionFrontLeftDrive, R_CANIDZionRearLeftDrive, R_CANIDZionRearRightDrive};
+            const int steerIDs[4] = {R_CANIDZionFrontRightSwerve, R_CANIDZionFrontLeftSwerve, R_CANIDZionRearLeftSwerve, R_CANIDZionRearRightSwerve};
+            for (int k = 0; k < 4; ++k) {
+
+                m_drive[k] = SparkMax(driveIDs[k]);
+                m_steer[k] = SparkMax(steerIDs[k]);
+            }
+            m_flywheel = SparkMax(R_CANIDMotorLauncherLaunchOne);
+            m_index = SparkMax(R_CANIDMotorLauncherIndex);
+
+            frc::sim::SimDeviceSim navX(("navX-Sensor[" + std::to_string((int)frc::SPI::kMXP) + "]").c_str());
+            m_navXYaw = navX.GetDouble("Yaw");
+
+            m_limelight = nt::NetworkTableInstance::GetDefault().GetTable("limelight-lnchr");
+            m_connected = true;
+        }
+
+        void update(const double &dt) {
+
+            if (!m_connected) {
+
+                return;
+            }
+            for (int k = 0; k < 4; ++k) {
+
+                m_swerve.setModuleOutputs(k, m_drive[k].output.Get(), m_steer[k].output.Get());
+            }
+            m_launcher.setOutputs(m_flywheel.output.Get(), m_index.output.Get());
+            m_swerve.update(dt);
+            m_launcher.update(dt);
+
+            for (int k = 0; k < 4; ++k) {
+
+                m_drive[k].position.Set(m_swerve.getDrivePosition(k));
+                m_drive[k].velocity.Set(m_swerve.getDriveVelocity(k));
+                m_steer[k].position.Set(m_swerve.getSteerPosition(k));
+            }
+            m_flywheel.velocity.Set(m_launcher.getFlywheelRPM());
+            m_index.current.Set(m_launcher.getIndexCurrent());
+
+            SwervePlant::Pose pose = m_swerve.getPose();
+            double yaw = pose.heading - 360 * floor((pose.heading + 180) / 360);
+            m_navXYaw.Set(yaw);
+            updateLimelight(pose);
+        }
+
+        int runHeadlessAuto(Robot &robot, const std::string &recording) {
+
+            std::vector<Recording::ControllerState> ideal;
+            if (!recording.empty()) {
+
+                std::string error = Recording::Load(Recorder::GetDirectory() + recording, ideal);
+                if (!error.empty()) {
+
+                    std::cerr << "Unable to use " << recording << " as the ideal path: " << error << std::endl;
+                    ideal.clear();
+                }
+            }
+            SwervePlant::Parameters instant;
+            instant.driveTimeConstant = 0;
+            instant.steerMaxRate = 1e6;
+            SwervePlant reference(instant);
+
+            //Simulated time only moves when stepped, so the run goes as fast
+            //as the robot code does, and auto sees exactly R_simLoopPeriod
+            //pass every loop.
+            SteppedClock clock(frc::Timer::GetFPGATimestamp());
+            AutoClock::Set(&clock);
+            frc::sim::PauseTiming();
+            frc::sim::DriverStationSim::SetAutonomous(true);
+            frc::sim::DriverStationSim::SetEnabled(true);
+            frc::sim::DriverStationSim::NotifyNewData();
+
+            robot.AutonomousInit();
+            int ticks = 0;
+            int maxTicks = (int)(R_simAutoTimeout / R_simLoopPeriod);
+            double worstError = 0;
+            double finalError = 0;
+            while (!robot.isAutoComplete() && ticks < maxTicks) {
+
+                robot.AutonomousPeriodic();
+                robot.RobotPeriodic();
+                update(R_simLoopPeriod);
+                if (!ideal.empty()) {
+
+                    if (ticks < (int)ideal.size()) {
+
+                        reference.driveChassis(ideal[ticks].x, ideal[ticks].y, ideal[ticks].z);
+                    }
+                    else {
+
+                        reference.driveChassis(0, 0, 0);
+                    }
+                    reference.update(R_simLoopPeriod);
+                    SwervePlant::Pose actual = m_swerve.getPose();
+                    SwervePlant::Pose expected = reference.getPose();
+                    finalError = VectorDouble(actual.i - expected.i, actual.j - expected.j).magnitude();
+                    worstError = finalError > worstError ? finalError : worstError;
+                }
+                frc::sim::StepTiming(units::second_t(R_simLoopPeriod));
+                clock.Step(R_simLoopPeriod);
+                ticks++;
+            }
+            AutoClock::Set(nullptr);
+            frc::sim::DriverStationSim::SetEnabled(false);
+            frc::sim::DriverStationSim::NotifyNewData();
+
+            bool complete = robot.isAutoComplete();
+            SwervePlant::Pose pose = m_swerve.getPose();
+            std::cout << std::fixed << std::setprecision(2);
+            std::cout << "Autonomous " << (complete ? "finished" : "timed out") << " after " << ticks * R_simLoopPeriod << " seconds" << std::endl;
+            std::cout << "Final pose: " << pose.i << " in right, " << pose.j << " in forward, heading " << pose.heading << " degrees" << std::endl;
+            std::cout << "Power Cells launched: " << m_launcher.getLaunched() << std::endl;
+            if (!ideal.empty()) {
+
+                std::cout << "Path error against " << recording << ": " << worstError << " in worst, " << finalError << " in final" << std::endl;
+            }
+            return complete ? 0 : 1;
+        }
+
+        SwervePlant& getSwerve() {
+
+            return m_swerve;
+        }
+        LauncherPlant& getLauncher() {
+
+            return m_launcher;
+        }
+
+    private:
+        //The values REV's simulated SPARK MAX exposes which the plants use.
+        struct SparkMax {
+
+            SparkMax() {}
+            SparkMax(const int &canID) {
+
+                frc::sim::SimDeviceSim device(("SPARK MAX [" + std::to_string(canID) + "]").c_str());
+                output = device.GetDouble("Applied Output");
+                position = device.GetDouble("Position");
+                velocity = device.GetDouble("Velocity");
+                current = device.GetDouble("Motor Current");
+            }
+
+            hal::SimDouble output;
+            hal::SimDouble position;
+            hal::SimDouble velocity;
+            hal::SimDouble current;
+        };
+
+        void updateLimelight(const SwervePlant::Pose &pose) {
+
+            VectorDouble toTarget(R_simTargetPositionI - pose.i, R_simTargetPositionJ - pose.j);
+            double distance = toTarget.magnitude();
+            //Bearings here are clockwise from the field's forward, like the
+            //heading, so their difference is the horizontal offset (tx).
+            double bearing = atan2(toTarget.i, toTarget.j) * (180 / M_PI);
+            double tx = bearing - pose.heading;
+            tx -= 360 * floor((tx + 180) / 360);
+            bool visible = distance > 1 && fabs(tx) < 29.8;
+
+            m_limelight->PutNumber("tv", visible ? 1 : 0);
+            m_limelight->PutNumber("tx", visible ? tx : 0);
+            m_limelight->PutNumber("ty", visible ? atan2(R_limelightTargetHeight - R_limelightMountHeight, distance) * (180 / M_PI) - R_limelightMountAngle : 0);
+            m_limelight->PutNumber("ta", visible ? R_simLimelightAreaDistanceSquared / (distance * distance) : 0);
+        }
+
+        SwervePlant m_swerve;
+        LauncherPlant m_launcher;
+        bool m_connected;
+        SparkMax m_drive[4];
+        SparkMax m_steer[4];
+        SparkMax m_flywheel;
+        SparkMax m_index;
+        hal::SimDouble m_navXYaw;
+        std::shared_ptr<NetworkTable> m_limelight;
+};
@@ -0,0 +1,214 @@
+/*
+class SwervePlant
+
+Constructors
+
+    SwervePlant()
+    SwervePlant(const SwervePlant::Parameters&)
+        Creates a model of Zion's drivetrain at the field origin, facing
+        forward, with the default or supplied physical parameters.
+
+Public Methods
+
+    void setModuleOutputs(const int&, const double&, const double&)
+        Sets the percent output of the drive then steer motor of the supplied
+        module (SwerveKinematics::Module), as its SPARK MAXes would apply it.
+    void driveChassis(const double&, const double&, const double&)
+        Sets every module's outputs to drive as SwerveTrain::Drive would for
+        the supplied field-oriented x, y and clockwise z, with a simple
+        proportional loop on each module's angle. Used where the real
+        SwerveTrain is not running, such as batch evaluation.
+    void update(const double&)
+        Advances the model by the supplied number of seconds.
+    void reset(const SwervePlant::Pose&)
+        Stops every module, points it forward, and moves Zion to the pose.
+
+    double getDrivePosition(const int&) / getSteerPosition(const int&)
+        Returns the encoder position of a module's drive or steer motor in
+        motor rotations, as its SPARK MAX would report it.
+    double getDriveVelocity(const int&)
+        Returns the drive motor's velocity in RPM.
+    SwervePlant::Pose getPose()
+        Returns Zion's position in inches (i to the right of its starting
+        point, j forward) and heading in degrees, clockwise like the NavX.
+
+    struct Parameters
+        Physical properties, defaulting to R_sim... in RobotMap. Setting a
+        time constant to 0 and the steer rate very high models ideal modules.
+        slip is the fraction of wheel speed lost to the carpet, and
+        voltageScale the fraction of full battery voltage available.
+
+Each module's steer encoder is assumed to read zero pointing forward and to
+rise as positive output turns it counterclockwise; its drive pushes along
+the way it points.
+Zion's motion is the least-squares fit of its four module velocities.
+*/
+
+#pragma once
+
+#include <math.h>
+
+#include "RobotMap.h"
+#include "SwerveKinematics.h"
+#include "VectorDouble.h"
+
+class SwervePlant {
+
+    public:
+        struct Parameters {
+
+            double driveMaxSpeed = R_simDriveMaxSpeed;
+            double driveTimeConstant = R_simDriveTimeConstant;
+            double steerMaxRate = R_simSteerMaxRate;
+            double moduleRadius = R_simModuleRadius;
+            double slip = 0;
+            double voltageScale = 1;
+        };
+
+        struct Pose {
+
+            double i;
+            double j;
+            double heading;
+        };
+
+        SwervePlant() : SwervePlant(Parameters()) {}
+        SwervePlant(const Parameters &parameters) {
+
+            m_parameters = parameters;
+            double angles[4];
+            angles[SwerveKinematics::kFrontRight] = R_angleFromCenterToFrontRightWheel;
+            angles[SwerveKinematics::kFrontLeft] = R_angleFromCenterToFrontLeftWheel;
+            angles[SwerveKinematics::kRearLeft] = R_angleFromCenterToRearLeftWheel;
+            angles[SwerveKinematics::kRearRight] = R_angleFromCenterToRearRightWheel;
+            for (int k = 0; k < 4; ++k) {
+
+                double radians = angles[k] * (M_PI / 180);
+                m_modulePositions[k] = VectorDouble(-sin(radians), cos(radians)).scaled(m_parameters.moduleRadius);
+            }
+            reset({0, 0, 0});
+        }
+
+        void setModuleOutputs(const int &module, const double &drive, const double &steer) {
+
+            m_driveOutputs[module] = clamp(drive);
+            m_steerOutputs[module] = clamp(steer);
+        }
+
+        void driveChassis(const double &x, const double &y, const double &z) {
+
+            driveChassis(x, y, z, m_pose.heading);
+        }
+        void driveChassis(const double &x, const double &y, const double &z, const double &yaw) {
+
+            //The command is field-oriented; the modules are not.
+            VectorDouble translation = VectorDouble(x, y).rotatedDeg(yaw);
+            SwerveKinematics::ModuleStates current;
+            SwerveKinematics::ModuleStates target;
+            for (int k = 0; k < 4; ++k) {
+
+                current.angle[k] = m_steerAngles[k];
+            }
+            SwerveKinematics::solve(translation.i, translation.j, z, current, target);
+            for (int k = 0; k < 4; ++k) {
+
+                //Turn toward the target at full speed until the last step,
+                //which would otherwise overshoot.
+                double turn = target.angle[k] - m_steerAngles[k];
+                turn -= 360 * floor((turn + 180) / 360);
+                double steer = turn / (m_parameters.steerMaxRate * R_simLoopPeriod);
+                setModuleOutputs(k, target.speed[k], steer);
+            }
+        }
+
+        void update(const double &dt) {
+
+            double available = m_parameters.voltageScale;
+            VectorDouble translation;
+            double rotation = 0;
+            for (int k = 0; k < 4; ++k) {
+
+                //Steer...
+                m_steerAngles[k] += m_steerOutputs[k] * available * m_parameters.steerMaxRate * dt;
+                m_steerAngles[k] -= 360 * floor(m_steerAngles[k] / 360);
+                m_steerRotations[k] += m_steerOutputs[k] * available * m_parameters.steerMaxRate * dt / 360 * R_nicsConstant;
+
+                //Drive...
+                double target = m_driveOutputs[k] * available * m_parameters.driveMaxSpeed;
+                if (m_parameters.driveTimeConstant > 0) {
+
+                    m_driveSpeeds[k] += (target - m_driveSpeeds[k]) * (1 - exp(-dt / m_parameters.driveTimeConstant));
+                }
+                else {
+
+                    m_driveSpeeds[k] = target;
+                }
+                m_driveRotations[k] += m_driveSpeeds[k] * dt / R_circumfrenceWheel * R_kuhnsConstant;
+
+                //And find what this module does to the chassis.
+                VectorDouble velocity = VectorDouble(1, 0).rotatedDeg(m_steerAngles[k]).scaled(m_driveSpeeds[k] * (1 - m_parameters.slip));
+                translation = translation + velocity;
+                VectorDouble position = m_modulePositions[k];
+                rotation += position.i * velocity.j - position.j * velocity.i;
+            }
+            //Averaging gives the chassis velocity, and the average moment about
+            //the center (counterclockwise) gives its rotation.
+            translation = translation.scaled(.25);
+            double radiusSquared = m_parameters.moduleRadius * m_parameters.moduleRadius;
+            double clockwiseRate = -(rotation / 4) / radiusSquared * (180 / M_PI);
+
+            //Turn the robot-relative translation back onto the field.
+            VectorDouble fieldVelocity = translation.rotatedDeg(-m_pose.heading);
+            m_pose.i += fieldVelocity.i * dt;
+            m_pose.j += fieldVelocity.j * dt;
+            m_pose.heading += clockwiseRate * dt;
+        }
+
+        void reset(const Pose &pose) {
+
+            m_pose = pose;
+            for (int k = 0; k < 4; ++k) {
+
+                m_driveOutputs[k] = 0;
+                m_steerOutputs[k] = 0;
+                m_driveSpeeds[k] = 0;
+                m_driveRotations[k] = 0;
+                m_steerRotations[k] = 0;
+                //Angles are on the unit circle, so forward is 90.
+                m_steerAngles[k] = 90;
+            }
+        }
+
+        double getDrivePosition(const int &module) {
+
+            return m_driveRotations[module];
+        }
+        double getDriveVelocity(const int &module) {
+
+            return m_driveSpeeds[module] / R_circumfrenceWheel * R_kuhnsConstant * 60;
+        }
+        double getSteerPosition(const int &module) {
+
+            return m_steerRotations[module];
+        }
+        Pose getPose() {
+
+            return m_pose;
+        }
+
+    private:
+        static double clamp(const double &output) {
+
+            return output < -1 ? -1 : (output > 1 ? 1 : output);
+        }
+
+        Parameters m_parameters;
+        VectorDouble m_modulePositions[4];
+        double m_driveOutputs[4];
+        double m_steerOutputs[4];
+        double m_driveSpeeds[4];
+        double m_driveRotations[4];
+        double m_steerRotations[4];
+        double m_steerAngles[4];
+        Pose m_pose;
+};
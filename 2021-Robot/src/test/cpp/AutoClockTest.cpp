@@ -0,0 +1,182 @@
+//Runs auto steps against a SteppedClock, a loop at a time, and checks that
+//they take exactly as many loops as they should, and exactly as many on
+//every run. Power Cells are launched by stepping LauncherPlant with what the
+//launcher's simulated SPARK MAXes are told, as RobotSimulation does.
+
+#include <string>
+
+#include <frc/simulation/SimDeviceSim.h>
+#include <hal/SimDevice.h>
+
+#include "gtest/gtest.h"
+
+#include "auto/AutoClock.h"
+#include "auto/steps/SetLauncherRPM.h"
+#include "auto/steps/ShootSequence.h"
+#include "auto/steps/WaitSeconds.h"
+#include "BallCounter.h"
+#include "Intake.h"
+#include "Launcher.h"
+#include "RobotMap.h"
+#include "sim/LauncherPlant.h"
+
+namespace {
+
+    //A power of two, so that stepped times add up exactly.
+    const double kLoop = 1.0 / 64;
+    const int kMaxLoops = 64 * 30;
+
+    //Clear of the robot's own devices, which the robot program constructs
+    //alongside these.
+    const int kCANIDIndex = 20;
+    const int kCANIDLaunchOne = 21;
+    const int kCANIDLaunchTwo = 22;
+    const int kCANIDIntake = 23;
+    const int kPWMPortRightServo = 8;
+    const int kPWMPortLeftServo = 9;
+
+    hal::SimDouble GetSparkMax(const int &canID, const char *field) {
+
+        frc::sim::SimDeviceSim device(("SPARK MAX [" + std::to_string(canID) + "]").c_str());
+        return device.GetDouble(field);
+    }
+}
+
+class AutoClockTest : public testing::Test {
+
+    protected:
+        static void SetUpTestSuite() {
+
+            //The devices can only be constructed once, so every test shares
+            //them.
+            intake = new Intake(kCANIDIntake);
+            launcher = new Launcher(kCANIDIndex, kCANIDLaunchOne, kCANIDLaunchTwo, kPWMPortRightServo, kPWMPortLeftServo);
+            ballCounter = new BallCounter(*intake, *launcher);
+        }
+
+        void SetUp() {
+
+            clock = new SteppedClock(1000);
+            AutoClock::Set(clock);
+            flywheelOutput = GetSparkMax(kCANIDLaunchOne, "Applied Output");
+            flywheelVelocity = GetSparkMax(kCANIDLaunchOne, "Velocity");
+            indexOutput = GetSparkMax(kCANIDIndex, "Applied Output");
+            indexCurrent = GetSparkMax(kCANIDIndex, "Motor Current");
+            launcher->setLaunchSpeed(0);
+            launcher->setIndexSpeed(0);
+            plant.reset(0);
+        }
+
+        void TearDown() {
+
+            AutoClock::Set(nullptr);
+            delete clock;
+        }
+
+        //Steps the launcher plant a loop with the launcher's outputs, and
+        //writes back what its sensors would read.
+        void updatePlant() {
+
+            plant.setOutputs(flywheelOutput.Get(), indexOutput.Get());
+            plant.update(kLoop);
+            flywheelVelocity.Set(plant.getFlywheelRPM());
+            indexCurrent.Set(plant.getIndexCurrent());
+        }
+
+        //Runs the step as auto would, and returns how many loops passed
+        //before it finished.
+        int run(AutoStep &step) {
+
+            step.Init();
+            int loops = 0;
+            while (!step.Execute() && loops < kMaxLoops) {
+
+                updatePlant();
+                clock->Step(kLoop);
+                loops++;
+            }
+            return loops;
+        }
+
+        //Spins the flywheel up at the supplied speed and loads the supplied
+        //number of Power Cells, with the ball counter set to the supplied
+        //count, then shoots as auto does. Returns the loops the shooting
+        //took.
+        int shoot(const int &powerCells, const int &counted, const int &shotsToTake) {
+
+            plant.reset(powerCells);
+            SetLauncherRPM spoolUp(*launcher, R_launcherDefaultSpeed, false);
+            run(spoolUp);
+            ballCounter->setCount(counted);
+            ShootSequence shootSequence(*launcher, *ballCounter, R_launcherDefaultSpeedIndex, shotsToTake);
+            return run(shootSequence);
+        }
+
+        static Intake *intake;
+        static Launcher *launcher;
+        static BallCounter *ballCounter;
+
+        SteppedClock *clock;
+        LauncherPlant plant;
+        hal::SimDouble flywheelOutput;
+        hal::SimDouble flywheelVelocity;
+        hal::SimDouble indexOutput;
+        hal::SimDouble indexCurrent;
+};
+
+Intake *AutoClockTest::intake = nullptr;
+Launcher *AutoClockTest::launcher = nullptr;
+BallCounter *AutoClockTest::ballCounter = nullptr;
+
+TEST_F(AutoClockTest, WaitSecondsTakesExactLoops) {
+
+    WaitSeconds wait(1);
+    EXPECT_EQ(run(wait), 64);
+    WaitSeconds again(1);
+    EXPECT_EQ(run(again), 64);
+    WaitSeconds none(0);
+    EXPECT_EQ(run(none), 0);
+}
+
+TEST_F(AutoClockTest, SetLauncherRPMWaitsForSpoolUpUnlessAsync) {
+
+    SetLauncherRPM sync(*launcher, R_launcherDefaultSpeed, false);
+    EXPECT_EQ(run(sync), (int)(R_launcherSpoolUpTime / kLoop));
+    EXPECT_NEAR(launcher->getLaunchRPM(), R_launcherDefaultSpeed * R_simFlywheelFreeRPM, R_launcherShootRecoveredToleranceRPM);
+
+    SetLauncherRPM async(*launcher, 0, true);
+    EXPECT_EQ(run(async), 0);
+    EXPECT_EQ(flywheelOutput.Get(), 0);
+}
+
+TEST_F(AutoClockTest, ShootSequenceLaunchesWhatWasCounted) {
+
+    int loops = shoot(3, 3, R_launcherMagazineCapacity);
+    EXPECT_EQ(plant.getLaunched(), 3);
+    EXPECT_EQ(plant.getPowerCells(), 0);
+    EXPECT_LT(loops, kMaxLoops);
+    EXPECT_EQ(indexOutput.Get(), 0);
+
+    EXPECT_EQ(shoot(3, 3, R_launcherMagazineCapacity), loops);
+    EXPECT_EQ(plant.getLaunched(), 3);
+}
+
+TEST_F(AutoClockTest, ShootSequenceStopsAtShotsRequested) {
+
+    int loops = shoot(3, 3, 2);
+    EXPECT_EQ(plant.getLaunched(), 2);
+    EXPECT_EQ(plant.getPowerCells(), 1);
+    EXPECT_EQ(shoot(3, 3, 2), loops);
+}
+
+TEST_F(AutoClockTest, ShootSequenceEmptiesMagazineWithoutCount) {
+
+    //Nothing counted falls back to finding the magazine empty, which
+    //corrects the count.
+    int loops = shoot(2, 0, R_launcherMagazineCapacity);
+    EXPECT_EQ(plant.getLaunched(), 2);
+    EXPECT_EQ(plant.getPowerCells(), 0);
+    EXPECT_EQ(ballCounter->getCount(), 0);
+    EXPECT_LT(loops, kMaxLoops);
+    EXPECT_EQ(shoot(2, 0, R_launcherMagazineCapacity), loops);
+}
@@ -0,0 +1,68 @@
+//Checks that recordings parse, and that damaged ones are refused with a
+//reason rather than throwing or being played in part.
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "auto/Recording.h"
+
+namespace {
+
+    //Two states, each written as Recorder does: offset by one, in
+    //R_zionAutoControllerTotalDigits characters.
+    const std::string kThreeChannel = "1.000001.500000.00000" "1.250001.000002.00000" "x";
+    const std::string kLockChannel = "L" "1.000001.500000.000002.00000" "1.250001.000002.000001.00000" "x";
+}
+
+TEST(RecordingTest, ParsesBothFormats) {
+
+    std::vector<Recording::ControllerState> values;
+    ASSERT_EQ(Recording::Parse(kThreeChannel, values), "");
+    ASSERT_EQ(values.size(), 2u);
+    EXPECT_DOUBLE_EQ(values[0].y, .5);
+    EXPECT_DOUBLE_EQ(values[0].z, -1);
+    EXPECT_DOUBLE_EQ(values[1].x, .25);
+    EXPECT_FALSE(values[0].limelightLock);
+
+    values.clear();
+    ASSERT_EQ(Recording::Parse(kLockChannel, values), "");
+    ASSERT_EQ(values.size(), 2u);
+    EXPECT_TRUE(values[0].limelightLock);
+    EXPECT_FALSE(values[1].limelightLock);
+    EXPECT_DOUBLE_EQ(values[1].z, 1);
+}
+
+TEST(RecordingTest, RefusesTruncatedRecordings) {
+
+    //Cut anywhere inside the last state, then ended as if complete, as well
+    //as cut without an end at all. (Cutting between states leaves a
+    //shorter recording, which is fine.)
+    for (const std::string &recording : {kThreeChannel, kLockChannel}) {
+
+        for (int cut = 2; cut <= 3 * R_zionAutoControllerTotalDigits; ++cut) {
+
+            std::vector<Recording::ControllerState> values;
+            std::string truncated = recording.substr(0, recording.size() - cut) + "x";
+            std::string error;
+            EXPECT_NO_THROW(error = Recording::Parse(truncated, values));
+            EXPECT_NE(error, "") << truncated;
+            EXPECT_TRUE(values.empty()) << truncated;
+
+            EXPECT_NO_THROW(error = Recording::Parse(recording.substr(0, recording.size() - cut), values));
+            EXPECT_NE(error, "");
+        }
+    }
+}
+
+TEST(RecordingTest, RefusesUnreadableStates) {
+
+    std::string garbled = kThreeChannel;
+    garbled.replace(21, 7, "abcdefg");
+    std::vector<Recording::ControllerState> values;
+    std::string error;
+    EXPECT_NO_THROW(error = Recording::Parse(garbled, values));
+    EXPECT_NE(error, "");
+    EXPECT_TRUE(values.empty());
+}
@@ -0,0 +1,108 @@
+//Steps the simulation's plant models through short routines and checks where
+//they end up, so that the models the simulation, Monte Carlo runs, and speed
+//curve tuning rely on stay right.
+
+#include <math.h>
+
+#include "gtest/gtest.h"
+
+#include "RobotMap.h"
+#include "sim/LauncherPlant.h"
+#include "sim/SwervePlant.h"
+
+namespace {
+
+    //Drives the plant as the commands would for the supplied seconds, a
+    //loop at a time.
+    void drive(SwervePlant &plant, const double &x, const double &y, const double &z, const double &seconds) {
+
+        int loops = (int)round(seconds / R_simLoopPeriod);
+        for (int loop = 0; loop < loops; ++loop) {
+
+            plant.driveChassis(x, y, z);
+            plant.update(R_simLoopPeriod);
+        }
+    }
+
+    void run(LauncherPlant &plant, const double &flywheel, const double &index, const double &seconds) {
+
+        int loops = (int)round(seconds / R_simLoopPeriod);
+        for (int loop = 0; loop < loops; ++loop) {
+
+            plant.setOutputs(flywheel, index);
+            plant.update(R_simLoopPeriod);
+        }
+    }
+}
+
+TEST(SimPlantTest, IdealSwerveFollowsRoutine) {
+
+    SwervePlant::Parameters instant;
+    instant.driveTimeConstant = 0;
+    instant.steerMaxRate = 1e6;
+    SwervePlant plant(instant);
+    plant.reset(SwervePlant::Pose {0, 0, 0});
+
+    //Forward, then a turn in place, then right across the field.
+    drive(plant, 0, .5, 0, 2);
+    SwervePlant::Pose pose = plant.getPose();
+    EXPECT_NEAR(pose.i, 0, 1e-6);
+    EXPECT_NEAR(pose.j, .5 * R_simDriveMaxSpeed * 2, 1e-6);
+    EXPECT_NEAR(pose.heading, 0, 1e-6);
+
+    drive(plant, 0, 0, .5, .5);
+    pose = plant.getPose();
+    //Turning at half speed moves each module half its top speed around the
+    //circle they sit on.
+    double turned = .5 * R_simDriveMaxSpeed / R_simModuleRadius * (180 / M_PI) * .5;
+    EXPECT_NEAR(pose.i, 0, 1e-3);
+    EXPECT_NEAR(pose.j, .5 * R_simDriveMaxSpeed * 2, 1e-3);
+    EXPECT_NEAR(pose.heading, turned, 1e-3);
+
+    //Field-oriented, so facing elsewhere still moves right.
+    drive(plant, .5, 0, 0, 1);
+    pose = plant.getPose();
+    EXPECT_NEAR(pose.i, .5 * R_simDriveMaxSpeed, 1e-3);
+    EXPECT_NEAR(pose.j, .5 * R_simDriveMaxSpeed * 2, 1e-3);
+    EXPECT_NEAR(pose.heading, turned, 1e-3);
+}
+
+TEST(SimPlantTest, SwerveLagsAndStops) {
+
+    SwervePlant plant;
+    plant.reset(SwervePlant::Pose {0, 0, 0});
+    drive(plant, 0, 1, 0, 1);
+    //A first-order lag falls behind by its time constant's worth of travel,
+    //less what stepping it a loop at a time loses.
+    double expected = R_simDriveMaxSpeed * (1 - R_simDriveTimeConstant * (1 - exp(-1 / R_simDriveTimeConstant)));
+    EXPECT_NEAR(plant.getPose().j, expected, 2);
+    drive(plant, 0, 0, 0, 2);
+    SwervePlant::Pose stopped = plant.getPose();
+    drive(plant, 0, 0, 0, 1);
+    EXPECT_NEAR(plant.getPose().j, stopped.j, 1e-2);
+    EXPECT_NEAR(plant.getPose().i, 0, 1e-6);
+}
+
+TEST(SimPlantTest, LauncherSpinsUpAndLaunchesMagazine) {
+
+    LauncherPlant plant;
+    plant.reset(3);
+    run(plant, R_launcherDefaultSpeed, 0, 3);
+    double spunUp = R_launcherDefaultSpeed * R_simFlywheelFreeRPM;
+    EXPECT_NEAR(plant.getFlywheelRPM(), spunUp, spunUp * .01);
+    EXPECT_EQ(plant.getLaunched(), 0);
+    EXPECT_EQ(plant.getIndexCurrent(), 0);
+
+    //Each Power Cell takes R_simIndexFeedTime of full index to launch, and
+    //summed loop periods fall just short of it, so a loop more.
+    run(plant, R_launcherDefaultSpeed, 1, R_simIndexFeedTime + R_simLoopPeriod);
+    EXPECT_EQ(plant.getLaunched(), 1);
+    EXPECT_LT(plant.getFlywheelRPM(), spunUp - R_simShotDipRPM / 2);
+    EXPECT_EQ(plant.getIndexCurrent(), R_simIndexLoadedCurrent);
+
+    run(plant, R_launcherDefaultSpeed, 1, 2);
+    EXPECT_EQ(plant.getLaunched(), 3);
+    EXPECT_EQ(plant.getPowerCells(), 0);
+    EXPECT_EQ(plant.getIndexCurrent(), R_simIndexFreeCurrent);
+    EXPECT_NEAR(plant.getFlywheelRPM(), spunUp, spunUp * .01);
+}
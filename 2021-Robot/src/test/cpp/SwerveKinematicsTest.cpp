@@ -0,0 +1,189 @@
+//Checks SwerveKinematics::solve against its plain loops and against a
+//double-precision solve written out module by module.
+
+#include <math.h>
+
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "RobotMap.h"
+#include "SwerveKinematics.h"
+
+namespace {
+
+    //The difference between two angles in degrees, -180 to 180.
+    double angleBetween(const double &a, const double &b) {
+
+        return remainder(a - b, 360);
+    }
+
+    //Each module's velocity (i, j) for the command, before desaturation,
+    //computed the long way.
+    void referenceVelocities(const double &x, const double &y, const double &z, double i[4], double j[4]) {
+
+        double angles[4];
+        angles[SwerveKinematics::kFrontRight] = R_angleFromCenterToFrontRightWheel;
+        angles[SwerveKinematics::kFrontLeft] = R_angleFromCenterToFrontLeftWheel;
+        angles[SwerveKinematics::kRearLeft] = R_angleFromCenterToRearLeftWheel;
+        angles[SwerveKinematics::kRearRight] = R_angleFromCenterToRearRightWheel;
+        for (int k = 0; k < 4; ++k) {
+
+            //Clockwise rotation moves a module at (-sin, cos) of its angle
+            //toward (cos, sin).
+            double radians = angles[k] * M_PI / 180;
+            i[k] = x + z * cos(radians);
+            j[k] = y + z * sin(radians);
+        }
+    }
+
+    SwerveKinematics::ModuleStates randomStates(std::mt19937 &random) {
+
+        std::uniform_real_distribution<float> angle(0, 360);
+        SwerveKinematics::ModuleStates states;
+        for (int k = 0; k < 4; ++k) {
+
+            states.speed[k] = 0;
+            states.angle[k] = angle(random);
+        }
+        return states;
+    }
+}
+
+TEST(SwerveKinematicsTest, MatchesScalarPath) {
+
+    std::mt19937 random(4624);
+    std::uniform_real_distribution<float> command(-1.5, 1.5);
+    for (int run = 0; run < 100000; ++run) {
+
+        float x = command(random);
+        float y = command(random);
+        float z = command(random);
+        SwerveKinematics::ModuleStates current = randomStates(random);
+        SwerveKinematics::ModuleStates simd;
+        SwerveKinematics::ModuleStates scalar;
+        SwerveKinematics::solve(x, y, z, current, simd);
+        SwerveKinematics::solveScalar(x, y, z, current, scalar);
+        for (int k = 0; k < 4; ++k) {
+
+            ASSERT_NEAR(simd.speed[k], scalar.speed[k], 1e-5) << "run " << run << " module " << k;
+            ASSERT_NEAR(angleBetween(simd.angle[k], scalar.angle[k]), 0, 1e-3) << "run " << run << " module " << k;
+        }
+    }
+}
+
+TEST(SwerveKinematicsTest, MatchesReference) {
+
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> command(-1.5, 1.5);
+    for (int run = 0; run < 10000; ++run) {
+
+        float x = command(random);
+        float y = command(random);
+        float z = command(random);
+        SwerveKinematics::ModuleStates current = randomStates(random);
+        SwerveKinematics::ModuleStates result;
+        SwerveKinematics::solve(x, y, z, current, result);
+
+        double i[4];
+        double j[4];
+        referenceVelocities(x, y, z, i, j);
+        double fastest = 1;
+        for (int k = 0; k < 4; ++k) {
+
+            fastest = fmax(fastest, hypot(i[k], j[k]));
+        }
+        for (int k = 0; k < 4; ++k) {
+
+            //Whichever way the module was flipped, it must move the same way.
+            double radians = result.angle[k] * M_PI / 180;
+            ASSERT_NEAR(result.speed[k] * cos(radians), i[k] / fastest, 1e-4) << "run " << run << " module " << k;
+            ASSERT_NEAR(result.speed[k] * sin(radians), j[k] / fastest, 1e-4) << "run " << run << " module " << k;
+        }
+    }
+}
+
+TEST(SwerveKinematicsTest, Desaturates) {
+
+    SwerveKinematics::ModuleStates current = SwerveKinematics::ModuleStates();
+    SwerveKinematics::ModuleStates result;
+    //Full translation and rotation together ask more than full speed of
+    //some modules.
+    SwerveKinematics::solve(1, 1, 1, current, result);
+
+    double i[4];
+    double j[4];
+    referenceVelocities(1, 1, 1, i, j);
+    double fastest = 0;
+    for (int k = 0; k < 4; ++k) {
+
+        fastest = fmax(fastest, hypot(i[k], j[k]));
+    }
+    ASSERT_GT(fastest, 1);
+    double fastestResult = 0;
+    for (int k = 0; k < 4; ++k) {
+
+        EXPECT_LE(fabs(result.speed[k]), 1 + 1e-6);
+        //Every module is scaled by the same amount.
+        EXPECT_NEAR(fabs(result.speed[k]), hypot(i[k], j[k]) / fastest, 1e-5);
+        fastestResult = fmax(fastestResult, fabs(result.speed[k]));
+    }
+    EXPECT_NEAR(fastestResult, 1, 1e-6);
+
+    //A command within full speed is left alone.
+    SwerveKinematics::solve(.5, 0, 0, current, result);
+    for (int k = 0; k < 4; ++k) {
+
+        EXPECT_NEAR(fabs(result.speed[k]), .5, 1e-6);
+    }
+}
+
+TEST(SwerveKinematicsTest, ReversesRatherThanTurnsPast90) {
+
+    SwerveKinematics::ModuleStates current = SwerveKinematics::ModuleStates();
+    SwerveKinematics::ModuleStates result;
+    //Pointing right (0) and asked to go left (180): stay put and reverse.
+    SwerveKinematics::solve(-1, 0, 0, current, result);
+    for (int k = 0; k < 4; ++k) {
+
+        EXPECT_NEAR(angleBetween(result.angle[k], 0), 0, 1e-4);
+        EXPECT_NEAR(result.speed[k], -1, 1e-6);
+    }
+    //Asked to go forward (90): turn, and keep driving forward.
+    SwerveKinematics::solve(0, 1, 0, current, result);
+    for (int k = 0; k < 4; ++k) {
+
+        EXPECT_NEAR(angleBetween(result.angle[k], 90), 0, 1e-4);
+        EXPECT_NEAR(result.speed[k], 1, 1e-6);
+    }
+
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> command(-1, 1);
+    for (int run = 0; run < 10000; ++run) {
+
+        SwerveKinematics::ModuleStates before = randomStates(random);
+        SwerveKinematics::solve(command(random), command(random), command(random), before, result);
+        for (int k = 0; k < 4; ++k) {
+
+            ASSERT_LE(fabs(angleBetween(result.angle[k], before.angle[k])), 90 + 1e-3) << "run " << run << " module " << k;
+            ASSERT_GE(result.angle[k], 0);
+            ASSERT_LT(result.angle[k], 360);
+        }
+    }
+}
+
+TEST(SwerveKinematicsTest, StillModulesKeepTheirAngle) {
+
+    SwerveKinematics::ModuleStates current = SwerveKinematics::ModuleStates();
+    for (int k = 0; k < 4; ++k) {
+
+        current.angle[k] = 30 * (k + 1);
+    }
+    SwerveKinematics::ModuleStates result;
+    SwerveKinematics::solve(0, 0, 0, current, result);
+    for (int k = 0; k < 4; ++k) {
+
+        EXPECT_EQ(result.speed[k], 0);
+        EXPECT_EQ(result.angle[k], current.angle[k]);
+    }
+}
@@ -0,0 +1,118 @@
+//BenchSwerveKinematics: Times SwerveKinematics::solve (SIMD where
+//available) against its plain loops, and against solving each module on
+//its own in double precision, the way a per-module drive call does. Run on
+//a desktop, or copy to the roboRIO to time it there.
+//
+//Usage:
+//    BenchSwerveKinematics [--solves <count>]
+//
+//Prints nanoseconds per solve of all four modules for each.
+
+#include <math.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "RobotMap.h"
+#include "SwerveKinematics.h"
+
+struct Command {
+
+    float x;
+    float y;
+    float z;
+};
+
+//One module at a time, as the swerve train solves them.
+void solveEachModule(const Command &command, const SwerveKinematics::ModuleStates &current, SwerveKinematics::ModuleStates &result) {
+
+    const double angles[4] = {
+        R_angleFromCenterToFrontRightWheel,
+        R_angleFromCenterToFrontLeftWheel,
+        R_angleFromCenterToRearLeftWheel,
+        R_angleFromCenterToRearRightWheel
+    };
+    double speeds[4];
+    double headings[4];
+    double fastest = 1;
+    for (int k = 0; k < 4; ++k) {
+
+        double radians = angles[k] * M_PI / 180;
+        double i = command.x + command.z * cos(radians);
+        double j = command.y + command.z * sin(radians);
+        speeds[k] = sqrt(i * i + j * j);
+        headings[k] = atan2(j, i) * 180 / M_PI;
+        fastest = speeds[k] > fastest ? speeds[k] : fastest;
+    }
+    for (int k = 0; k < 4; ++k) {
+
+        double turn = remainder(headings[k] - current.angle[k], 360);
+        double speed = speeds[k] / fastest;
+        if (fabs(turn) > 90) {
+
+            turn -= turn > 0 ? 180 : -180;
+            speed = -speed;
+        }
+        double angle = current.angle[k] + turn;
+        result.speed[k] = speed;
+        result.angle[k] = angle - 360 * floor(angle / 360);
+    }
+}
+
+template <typename Solve> double time(const std::vector<Command> &commands, Solve solve) {
+
+    SwerveKinematics::ModuleStates states = SwerveKinematics::ModuleStates();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (const Command &command : commands) {
+
+        //Feed each result back in, as the robot does, so that no solve can
+        //be skipped.
+        solve(command, states, states);
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    volatile float sink = states.speed[0] + states.angle[3];
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(end - start).count() / commands.size();
+}
+
+int main(int argc, char **argv) {
+
+    long solves = 2000000;
+    for (int arg = 1; arg < argc; ++arg) {
+
+        std::string option = argv[arg];
+        if (option == "--solves" && arg + 1 < argc) {
+
+            solves = atol(argv[++arg]);
+        }
+        else {
+
+            std::cerr << "Usage: BenchSwerveKinematics [--solves <count>]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::mt19937 random(4624);
+    std::uniform_real_distribution<float> axis(-1, 1);
+    std::vector<Command> commands(solves);
+    for (Command &command : commands) {
+
+        command = Command {axis(random), axis(random), axis(random)};
+    }
+
+#if defined(__SSE__)
+    const char *simd = "SSE";
+#else
+    const char *simd = "none";
+#endif
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "solve (SIMD: " << simd << ")  " << time(commands, [](const Command &c, const SwerveKinematics::ModuleStates &current, SwerveKinematics::ModuleStates &result) { SwerveKinematics::solve(c.x, c.y, c.z, current, result); }) << " ns" << std::endl;
+    std::cout << "solveScalar         " << time(commands, [](const Command &c, const SwerveKinematics::ModuleStates &current, SwerveKinematics::ModuleStates &result) { SwerveKinematics::solveScalar(c.x, c.y, c.z, current, result); }) << " ns" << std::endl;
+    std::cout << "each module, double " << time(commands, solveEachModule) << " ns" << std::endl;
+    return 0;
+}
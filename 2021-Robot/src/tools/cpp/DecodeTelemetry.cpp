@@ -0,0 +1,115 @@
+//DecodeTelemetry: Turns the binary telemetry logs written by TelemetryLogger
+//(telemetry-<session>-<part>.bin, from the USB stick) into CSV. Run on a
+//desktop.
+//
+//Usage:
+//    DecodeTelemetry [--out <csv>] <log>...
+//
+//Rows are time (seconds since the robot program started), signal, value.
+//Pass a session's parts in order to get one continuous CSV. A truncated
+//file, such as one cut off by pulling the USB stick, is decoded up to where
+//it ends.
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "TelemetryFormat.h"
+
+bool decodeFile(const std::string &path, std::ostream &out, long &rows) {
+
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+
+        std::cerr << "Unable to open " << path << std::endl;
+        return false;
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    std::string in = contents.str();
+
+    TelemetryDecoder decoder;
+    size_t offset = 0;
+    if (!decoder.begin(in, offset)) {
+
+        std::cerr << path << " is not a telemetry log" << std::endl;
+        return false;
+    }
+    std::vector<std::string> names;
+    TelemetryDecoder::Entry entry;
+    while (true) {
+
+        int result = decoder.next(in, offset, entry);
+        if (result == TelemetryDecoder::kDefinition) {
+
+            if (entry.signal >= names.size()) {
+
+                names.resize(entry.signal + 1);
+            }
+            names[entry.signal] = entry.name;
+        }
+        else if (result == TelemetryDecoder::kRecord) {
+
+            out << std::fixed << std::setprecision(6) << entry.time / 1e6 << ',' << names[entry.signal] << ',' << std::defaultfloat << std::setprecision(9) << entry.value << '\n';
+            rows++;
+        }
+        else {
+
+            if (result == TelemetryDecoder::kCorrupt) {
+
+                std::cerr << path << ": stopped at byte " << offset << " of " << in.size() << ", which does not decode" << std::endl;
+            }
+            break;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+
+    std::string outputPath;
+    std::vector<std::string> sources;
+    for (int i = 1; i < argc; ++i) {
+
+        std::string argument = argv[i];
+        if (argument == "--out" && i + 1 < argc) {
+
+            outputPath = argv[++i];
+        }
+        else {
+
+            sources.push_back(argument);
+        }
+    }
+    if (sources.empty()) {
+
+        std::cerr << "Usage: DecodeTelemetry [--out <csv>] <log>..." << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!outputPath.empty()) {
+
+        file.open(outputPath, std::ios::out | std::ios::trunc);
+        if (!file.is_open()) {
+
+            std::cerr << "Unable to open " << outputPath << std::endl;
+            return 1;
+        }
+    }
+    std::ostream &out = outputPath.empty() ? std::cout : file;
+    out << "time,signal,value\n";
+    long rows = 0;
+    for (const std::string &source : sources) {
+
+        if (!decodeFile(source, out, rows)) {
+
+            return 1;
+        }
+    }
+    std::cerr << "Decoded " << rows << " records" << std::endl;
+    return 0;
+}
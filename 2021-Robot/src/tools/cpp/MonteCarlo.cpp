@@ -0,0 +1,420 @@
+//MonteCarlo: Runs an autonomous routine through the simulation's plant models
+//thousands of times under randomized conditions (sensor noise, wheel slip,
+//battery sag, and error in the starting pose), spread across every core, and
+//reports the distributions of how long it took and how far from its intended
+//end it finished. Use it to find the fastest settings in RobotMap.h that are
+//still reliable. Run on a desktop from the 2021-Robot directory.
+//
+//Usage:
+//    MonteCarlo [--runs <count>] [--threads <count>] [--seed <seed>] [--csv <file>] <routine>
+//
+//A routine is a text file with one step per line, standing in for the auto
+//step of the same purpose (blank lines and lines starting with # are
+//skipped):
+//    direction <i> <j>             AssumeDirectionAbsolute
+//    distance <inches> <i> <j>     AssumeDistance
+//    play <recording>              RunPrerecorded, from R_simRecordingDirectory
+//
+//SwerveTrain cannot run off the robot, so its module angle loop is stood in
+//for by R_speedCurveAssumePosition, and Drive() by
+//SwervePlant::driveChassis. The intended end is where the routine finishes
+//with no disturbances at all.
+//Every run draws its conditions from its own seed, so results are the same
+//however many threads there are.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "auto/Recording.h"
+#include "RobotMap.h"
+#include "sim/SwervePlant.h"
+#include "SpeedCurve.h"
+#include "SwerveKinematics.h"
+#include "VectorDouble.h"
+
+//The spread of each randomized condition. Noise and starting error are
+//standard deviations; slip and battery are drawn uniformly from their range.
+const double R_monteCarloEncoderNoise = .02;
+const double R_monteCarloYawNoise = .5;
+const double R_monteCarloSlipMax = .1;
+const double R_monteCarloVoltageMin = .8;
+const double R_monteCarloStartPositionError = 2;
+const double R_monteCarloStartHeadingError = 2;
+
+struct Step {
+
+    enum Kind {
+
+        kDirection,
+        kDistance,
+        kPlay
+    };
+
+    Kind kind;
+    double distance;
+    VectorDouble direction;
+    std::vector<Recording::ControllerState> recording;
+};
+
+struct Conditions {
+
+    double encoderNoise;
+    double yawNoise;
+    double slip;
+    double voltageScale;
+    SwervePlant::Pose start;
+};
+
+struct Result {
+
+    bool complete;
+    double time;
+    SwervePlant::Pose end;
+    double positionError;
+    double headingError;
+};
+
+bool readRoutine(const std::string &path, std::vector<Step> &steps) {
+
+    std::ifstream file(path);
+    if (!file.is_open()) {
+
+        std::cerr << "Unable to open " << path << std::endl;
+        return false;
+    }
+    std::string row;
+    int line = 0;
+    while (std::getline(file, row)) {
+
+        line++;
+        std::istringstream words(row);
+        std::string kind;
+        if (!(words >> kind) || kind[0] == '#') {
+
+            continue;
+        }
+        Step step;
+        double i = 0, j = 0;
+        bool valid = false;
+        if (kind == "direction") {
+
+            step.kind = Step::kDirection;
+            valid = (bool)(words >> i >> j);
+            step.direction = VectorDouble(i, j);
+        }
+        else if (kind == "distance") {
+
+            step.kind = Step::kDistance;
+            valid = (bool)(words >> step.distance >> i >> j);
+            step.direction = VectorDouble(i, j).toStandard();
+        }
+        else if (kind == "play") {
+
+            step.kind = Step::kPlay;
+            std::string name;
+            valid = (bool)(words >> name);
+            if (valid) {
+
+                std::string error = Recording::Load(R_simRecordingDirectory + name, step.recording);
+                if (!error.empty()) {
+
+                    std::cerr << path << ":" << line << ": " << name << ": " << error << std::endl;
+                    return false;
+                }
+            }
+        }
+        if (!valid) {
+
+            std::cerr << path << ":" << line << ": unable to read step \"" << row << "\"" << std::endl;
+            return false;
+        }
+        steps.push_back(step);
+    }
+    if (steps.empty()) {
+
+        std::cerr << path << " has no steps" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void stop(SwervePlant &plant) {
+
+    for (int k = 0; k < 4; ++k) {
+
+        plant.setModuleOutputs(k, 0, 0);
+    }
+}
+
+//Stands in for SwerveTrain::SetZionMotorsToVector: turns every module toward
+//the vector, returning true once all are within tolerance.
+bool assumeDirection(SwervePlant &plant, const VectorDouble &direction) {
+
+    bool done = true;
+    for (int k = 0; k < 4; ++k) {
+
+        double angle = 90 + plant.getSteerPosition(k) / R_nicsConstant * 360;
+        double turn = direction.unitCircleAngleDeg() - angle;
+        turn -= 360 * floor((turn + 180) / 360);
+        double remaining = turn / 360 * R_nicsConstant;
+        double speed = R_speedCurveAssumePosition.speed(remaining);
+        plant.setModuleOutputs(k, 0, speed);
+        done = done && speed == 0;
+    }
+    return done;
+}
+
+Result run(const std::vector<Step> &steps, const Conditions &conditions, const unsigned int seed) {
+
+    std::mt19937 random(seed);
+    std::normal_distribution<double> encoderNoise(0, conditions.encoderNoise > 0 ? conditions.encoderNoise : 1e-12);
+    std::normal_distribution<double> yawNoise(0, conditions.yawNoise > 0 ? conditions.yawNoise : 1e-12);
+
+    SwervePlant::Parameters parameters;
+    parameters.slip = conditions.slip;
+    parameters.voltageScale = conditions.voltageScale;
+    SwervePlant plant(parameters);
+    plant.reset(conditions.start);
+
+    int ticks = 0;
+    int maxTicks = (int)(R_simAutoTimeout / R_simLoopPeriod);
+    unsigned int current = 0;
+    bool started = false;
+    double targetPosition = 0;
+    unsigned int played = 0;
+    while (current < steps.size() && ticks < maxTicks) {
+
+        const Step &step = steps[current];
+        //The NavX was zeroed wherever Zion really started.
+        double yaw = plant.getPose().heading - conditions.start.heading + yawNoise(random);
+        double drivePosition = plant.getDrivePosition(SwerveKinematics::kFrontRight) + encoderNoise(random);
+        bool done = false;
+        switch (step.kind) {
+
+            case Step::kDirection:
+                done = assumeDirection(plant, step.direction);
+                break;
+
+            case Step::kDistance:
+                if (!started) {
+
+                    targetPosition = drivePosition + (step.distance * R_kuhnsConstant) / R_circumfrenceWheel;
+                }
+                if (std::abs(targetPosition - drivePosition) > R_kuhnsConstant * .1) {
+
+                    plant.driveChassis(step.direction.i, step.direction.j, 0, yaw);
+                }
+                else {
+
+                    stop(plant);
+                    done = true;
+                }
+                break;
+
+            case Step::kPlay:
+                if (!started) {
+
+                    played = 0;
+                }
+                if (played < step.recording.size()) {
+
+                    const Recording::ControllerState &state = step.recording[played++];
+                    plant.driveChassis(state.x, state.y, state.z, yaw);
+                }
+                else {
+
+                    stop(plant);
+                    done = true;
+                }
+                break;
+        }
+        started = !done;
+        if (done) {
+
+            current++;
+        }
+        plant.update(R_simLoopPeriod);
+        ticks++;
+    }
+
+    Result result;
+    result.complete = current == steps.size();
+    result.time = ticks * R_simLoopPeriod;
+    result.end = plant.getPose();
+    result.positionError = 0;
+    result.headingError = 0;
+    return result;
+}
+
+Conditions drawConditions(const unsigned int seed) {
+
+    std::mt19937 random(seed);
+    std::normal_distribution<double> startPosition(0, R_monteCarloStartPositionError);
+    std::normal_distribution<double> startHeading(0, R_monteCarloStartHeadingError);
+    std::uniform_real_distribution<double> slip(0, R_monteCarloSlipMax);
+    std::uniform_real_distribution<double> voltage(R_monteCarloVoltageMin, 1);
+
+    Conditions conditions;
+    conditions.encoderNoise = R_monteCarloEncoderNoise;
+    conditions.yawNoise = R_monteCarloYawNoise;
+    conditions.slip = slip(random);
+    conditions.voltageScale = voltage(random);
+    conditions.start.i = startPosition(random);
+    conditions.start.j = startPosition(random);
+    conditions.start.heading = startHeading(random);
+    return conditions;
+}
+
+void printDistribution(const std::string &name, std::vector<double> values) {
+
+    if (values.empty()) {
+
+        return;
+    }
+    std::sort(values.begin(), values.end());
+    double sum = 0;
+    for (double value : values) {
+
+        sum += value;
+    }
+    auto percentile = [&values](const double fraction) {
+
+        return values[std::min(values.size() - 1, (size_t)(fraction * values.size()))];
+    };
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(2)
+        << " mean " << std::setw(8) << sum / values.size()
+        << " p50 " << std::setw(8) << percentile(.5)
+        << " p90 " << std::setw(8) << percentile(.9)
+        << " p99 " << std::setw(8) << percentile(.99)
+        << " max " << std::setw(8) << values.back() << std::endl;
+}
+
+int main(int argc, char **argv) {
+
+    int runs = 1000;
+    int threads = std::thread::hardware_concurrency();
+    unsigned int seed = 2021;
+    std::string csvPath;
+    std::string routinePath;
+    for (int i = 1; i < argc; ++i) {
+
+        std::string argument = argv[i];
+        if (argument == "--runs" && i + 1 < argc) {
+
+            runs = std::stoi(argv[++i]);
+        }
+        else if (argument == "--threads" && i + 1 < argc) {
+
+            threads = std::stoi(argv[++i]);
+        }
+        else if (argument == "--seed" && i + 1 < argc) {
+
+            seed = std::stoul(argv[++i]);
+        }
+        else if (argument == "--csv" && i + 1 < argc) {
+
+            csvPath = argv[++i];
+        }
+        else {
+
+            routinePath = argument;
+        }
+    }
+    if (routinePath.empty() || runs < 1) {
+
+        std::cerr << "Usage: MonteCarlo [--runs <count>] [--threads <count>] [--seed <seed>] [--csv <file>] <routine>" << std::endl;
+        return 1;
+    }
+    threads = std::max(1, std::min(threads, runs));
+
+    std::vector<Step> steps;
+    if (!readRoutine(routinePath, steps)) {
+
+        return 1;
+    }
+
+    //Where the routine ends when nothing goes wrong.
+    Conditions ideal = {0, 0, 0, 1, {0, 0, 0}};
+    Result intended = run(steps, ideal, seed);
+    if (!intended.complete) {
+
+        std::cerr << "Warning: the routine does not finish within " << R_simAutoTimeout << " seconds even with no disturbances" << std::endl;
+    }
+
+    //Each worker takes the next run until there are none left. Runs are
+    //independent, so nothing else is shared.
+    std::vector<Conditions> conditions(runs);
+    std::vector<Result> results(runs);
+    std::atomic<int> next(0);
+    auto started = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+
+        workers.emplace_back([&]() {
+
+            for (int k = next++; k < runs; k = next++) {
+
+                conditions[k] = drawConditions(seed + 1 + 2 * k);
+                Result result = run(steps, conditions[k], seed + 2 + 2 * k);
+                result.positionError = VectorDouble(result.end.i - intended.end.i, result.end.j - intended.end.j).magnitude();
+                result.headingError = std::abs(result.end.heading - intended.end.heading);
+                results[k] = result;
+            }
+        });
+    }
+    for (std::thread &worker : workers) {
+
+        worker.join();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    std::vector<double> times, positionErrors, headingErrors;
+    int complete = 0;
+    for (const Result &result : results) {
+
+        if (result.complete) {
+
+            complete++;
+            times.push_back(result.time);
+        }
+        positionErrors.push_back(result.positionError);
+        headingErrors.push_back(result.headingError);
+    }
+    std::cout << routinePath << ": " << runs << " runs on " << threads << " threads in " << std::fixed << std::setprecision(2) << elapsed << " seconds" << std::endl;
+    std::cout << "Intended: " << intended.time << " seconds, ending " << intended.end.i << " in right, " << intended.end.j << " in forward, heading " << intended.end.heading << std::endl;
+    std::cout << "Finished: " << complete << " of " << runs << " within " << R_simAutoTimeout << " seconds" << std::endl;
+    printDistribution("Completion time (s)", times);
+    printDistribution("Final position error (in)", positionErrors);
+    printDistribution("Final heading error (deg)", headingErrors);
+
+    if (!csvPath.empty()) {
+
+        std::ofstream csv(csvPath, std::ios::out | std::ios::trunc);
+        if (!csv.is_open()) {
+
+            std::cerr << "Unable to open " << csvPath << std::endl;
+            return 1;
+        }
+        csv << "slip,voltage,start_i,start_j,start_heading,complete,time,end_i,end_j,end_heading,position_error,heading_error\n";
+        csv << std::setprecision(6);
+        for (int k = 0; k < runs; ++k) {
+
+            const Conditions &c = conditions[k];
+            const Result &r = results[k];
+            csv << c.slip << ',' << c.voltageScale << ',' << c.start.i << ',' << c.start.j << ',' << c.start.heading << ','
+                << (r.complete ? 1 : 0) << ',' << r.time << ',' << r.end.i << ',' << r.end.j << ',' << r.end.heading << ','
+                << r.positionError << ',' << r.headingError << '\n';
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,246 @@
+//RefitLauncherModel: Rebuilds LauncherCalibration.h from launcher calibration
+//CSVs, such as those in data/ or those recorded on the robot by
+//CalibrationLogger. Run on a desktop, then rebuild and deploy.
+//
+//Usage:
+//    RefitLauncherModel [--launch <speed>] [--out <header>] <csv>...
+//
+//Only shots taken at the launch speed (R_launcherDefaultSpeed by default)
+//that were marked as scoring are kept. Files without a hit column are
+//treated as all scoring, and files without a launch column as all taken at
+//the requested speed. Shots whose areas are within R_refitMergeArea of each
+//other are averaged into one point, as the model needs strictly increasing
+//areas and repeated shots are better averaged than picked between.
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "RobotMap.h"
+
+const double R_refitMergeArea = .005;
+const double R_refitLaunchTolerance = .001;
+
+struct Shot {
+
+    double area;
+    double rpm;
+    double servo;
+};
+
+std::vector<std::string> splitRow(const std::string &row) {
+
+    std::vector<std::string> cells;
+    std::stringstream stream(row);
+    std::string cell;
+    while (std::getline(stream, cell, ',')) {
+
+        //Tolerate files saved on Windows.
+        if (!cell.empty() && cell.back() == '\r') {
+
+            cell.pop_back();
+        }
+        cells.push_back(cell);
+    }
+    return cells;
+}
+
+int findColumn(const std::vector<std::string> &header, const std::string &name) {
+
+    auto found = std::find(header.begin(), header.end(), name);
+    return found == header.end() ? -1 : found - header.begin();
+}
+
+bool readShots(const std::string &path, const double launch, std::vector<Shot> &shots) {
+
+    std::ifstream file(path);
+    if (!file.is_open()) {
+
+        std::cerr << "Unable to open " << path << std::endl;
+        return false;
+    }
+    std::string row;
+    std::getline(file, row);
+    std::vector<std::string> header = splitRow(row);
+    int areaColumn = findColumn(header, "area");
+    int rpmColumn = findColumn(header, "rpm");
+    int servoColumn = findColumn(header, "servo");
+    int launchColumn = findColumn(header, "launch");
+    int hitColumn = findColumn(header, "hit");
+    if (areaColumn < 0 || rpmColumn < 0 || servoColumn < 0) {
+
+        std::cerr << path << " needs area, rpm, and servo columns" << std::endl;
+        return false;
+    }
+    //The hand-made files carry the launch speed in an unlabeled fourth column.
+    if (launchColumn < 0 && header.size() == 3) {
+
+        launchColumn = 3;
+    }
+
+    int kept = 0;
+    int total = 0;
+    //The header is line 1.
+    int line = 1;
+    while (std::getline(file, row)) {
+
+        line++;
+        std::vector<std::string> cells = splitRow(row);
+        if (cells.size() < header.size()) {
+
+            continue;
+        }
+        total++;
+        //std::stod throws on a cell which is not a number (or is out of
+        //range), which should name the row rather than end the tool.
+        try {
+
+            if (launchColumn >= 0 && launchColumn < (int)cells.size() && std::abs(std::stod(cells[launchColumn]) - launch) > R_refitLaunchTolerance) {
+
+                continue;
+            }
+            if (hitColumn >= 0 && std::stod(cells[hitColumn]) == 0) {
+
+                continue;
+            }
+            shots.push_back({std::stod(cells[areaColumn]), std::abs(std::stod(cells[rpmColumn])), std::stod(cells[servoColumn])});
+        }
+        catch (const std::logic_error&) {
+
+            std::cerr << path << ":" << line << ": expected numbers, found \"" << row << "\"" << std::endl;
+            return false;
+        }
+        kept++;
+    }
+    std::cerr << path << ": kept " << kept << " of " << total << " shots" << std::endl;
+    return true;
+}
+
+std::vector<Shot> mergeShots(std::vector<Shot> shots) {
+
+    std::sort(shots.begin(), shots.end(), [](const Shot &a, const Shot &b) {return a.area < b.area;});
+    std::vector<Shot> merged;
+    unsigned int first = 0;
+    while (first < shots.size()) {
+
+        unsigned int last = first;
+        Shot sum = shots[first];
+        while (last + 1 < shots.size() && shots[last + 1].area - shots[first].area < R_refitMergeArea) {
+
+            last++;
+            sum.area += shots[last].area;
+            sum.rpm += shots[last].rpm;
+            sum.servo += shots[last].servo;
+        }
+        double count = last - first + 1;
+        merged.push_back({sum.area / count, sum.rpm / count, sum.servo / count});
+        first = last + 1;
+    }
+    return merged;
+}
+
+void writeHeader(std::ostream &out, const std::vector<Shot> &points, const std::vector<std::string> &sources, const double launch) {
+
+    std::string sourceList;
+    for (unsigned int i = 0; i < sources.size(); ++i) {
+
+        sourceList += (i == 0 ? "" : ", ") + sources[i];
+    }
+    out << "//LauncherCalibration: Measured launcher calibration points, sorted by target\n";
+    out << "//area. Generated by RefitLauncherModel from " << sourceList << ",\n";
+    out << "//keeping only scoring shots taken at a launch speed of " << launch << ". RPM is\n";
+    out << "//stored as a magnitude. Regenerate rather than editing by hand.\n";
+    out << "\n";
+    out << "#pragma once\n";
+    out << "\n";
+    out << "struct LauncherCalibrationPoint {\n";
+    out << "\n";
+    out << "    double area;\n";
+    out << "    double rpm;\n";
+    out << "    double servo;\n";
+    out << "};\n";
+    out << "\n";
+    out << "constexpr LauncherCalibrationPoint R_launcherCalibration[] = {\n";
+    out << "\n";
+    for (unsigned int i = 0; i < points.size(); ++i) {
+
+        std::ostringstream area, rpm, servo;
+        area << std::setprecision(6) << points[i].area << ',';
+        rpm << std::setprecision(6) << points[i].rpm << ',';
+        servo << std::setprecision(6) << points[i].servo;
+        out << "    {" << std::left << std::setw(9) << area.str() << std::setw(9) << rpm.str() << servo.str() << '}' << (i + 1 < points.size() ? "," : "") << '\n';
+    }
+    out << "};\n";
+}
+
+int main(int argc, char **argv) {
+
+    double launch = R_launcherDefaultSpeed;
+    std::string outputPath = "src/main/include/LauncherCalibration.h";
+    std::vector<std::string> sources;
+    for (int i = 1; i < argc; ++i) {
+
+        std::string argument = argv[i];
+        if (argument == "--launch" && i + 1 < argc) {
+
+            try {
+
+                launch = std::stod(argv[++i]);
+            }
+            catch (const std::logic_error&) {
+
+                std::cerr << "--launch needs a number, found \"" << argv[i] << "\"" << std::endl;
+                return 1;
+            }
+        }
+        else if (argument == "--out" && i + 1 < argc) {
+
+            outputPath = argv[++i];
+        }
+        else {
+
+            sources.push_back(argument);
+        }
+    }
+    if (sources.empty()) {
+
+        std::cerr << "Usage: RefitLauncherModel [--launch <speed>] [--out <header>] <csv>..." << std::endl;
+        return 1;
+    }
+
+    std::vector<Shot> shots;
+    for (const std::string &source : sources) {
+
+        if (!readShots(source, launch, shots)) {
+
+            return 1;
+        }
+    }
+    std::vector<Shot> points = mergeShots(shots);
+    if (points.size() < 2) {
+
+        std::cerr << "Need at least two distinct calibration points, found " << points.size() << std::endl;
+        return 1;
+    }
+
+    std::ofstream output(outputPath, std::ios::out | std::ios::trunc);
+    if (!output.is_open()) {
+
+        std::cerr << "Unable to open " << outputPath << std::endl;
+        return 1;
+    }
+    std::vector<std::string> names;
+    for (const std::string &source : sources) {
+
+        names.push_back(source.substr(source.find_last_of('/') + 1));
+    }
+    writeHeader(output, points, names, launch);
+    std::cerr << "Wrote " << points.size() << " calibration points to " << outputPath << std::endl;
+    return 0;
+}
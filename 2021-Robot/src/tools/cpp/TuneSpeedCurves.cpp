@@ -0,0 +1,390 @@
+//TuneSpeedCurves: Searches for the end behavior breakpoints and speeds of
+//Zion's three speed curves (assuming a position, Limelight lock, and holding
+//an angle) against the simulation's plants, and rewrites
+//SpeedCurveConstants.h with the result. Run on a desktop from the 2021-Robot
+//directory, then rebuild and deploy.
+//
+//Usage:
+//    TuneSpeedCurves [--overshoot <tolerances>] [--out <header>]
+//
+//Each curve is scored by its mean settle time over a set of starting
+//distances: the time until the remaining distance enters the tolerance and
+//stays there. A curve which overshoots by more than the supplied number of
+//its tolerances (1 by default), or never settles, is penalized past any
+//curve which does not. The search is Nelder-Mead over the four end behavior
+//values, from several scalings of the hand-picked curve. Tolerances are
+//requirements rather than tuning, so they are left alone.
+//
+//Assuming a position turns one module at a time with SwervePlant's steer
+//model; the Limelight lock and holding an angle turn the whole chassis in
+//place, with its drive lag.
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "RobotMap.h"
+#include "sim/SwervePlant.h"
+#include "SpeedCurve.h"
+
+const double R_tuneSettleTime = .25;
+const double R_tuneTimeout = 5;
+const double R_tunePenalty = 100;
+const int R_tuneIterations = 500;
+const int R_tuneRestarts = 5;
+
+struct Family {
+
+    std::string name;
+    SpeedCurve curve;
+    std::vector<double> starts;
+    //Moves the plant one loop toward closing the supplied remaining
+    //distance at the supplied speed, and returns the new remaining distance.
+    std::function<double(SwervePlant&, const double&, const double&)> step;
+    //Returns the remaining distance before the first step.
+    std::function<double(SwervePlant&, const double&)> begin;
+};
+
+//Scores a curve: the mean settle time over every start, plus penalties.
+double score(const Family &family, const SpeedCurve &curve, const double overshootTolerances) {
+
+    //Keep the search where the curve makes sense.
+    if (curve.firstEndBehaviorAt <= curve.secondEndBehaviorAt || curve.secondEndBehaviorAt <= curve.tolerance ||
+        curve.firstEndBehaviorSpeed <= 0 || curve.firstEndBehaviorSpeed > 1 ||
+        curve.secondEndBehaviorSpeed <= 0 || curve.secondEndBehaviorSpeed > 1) {
+
+        return 1e9;
+    }
+    double total = 0;
+    for (double start : family.starts) {
+
+        SwervePlant plant;
+        double remaining = family.begin(plant, start);
+        double initialSign = remaining < 0 ? -1 : 1;
+        double overshoot = 0;
+        double settledAt = -1;
+        int maxTicks = (int)(R_tuneTimeout / R_simLoopPeriod);
+        for (int tick = 0; tick < maxTicks; ++tick) {
+
+            remaining = family.step(plant, remaining, curve.speed(remaining));
+            overshoot = std::max(overshoot, -remaining * initialSign);
+            double now = (tick + 1) * R_simLoopPeriod;
+            if (std::abs(remaining) < curve.tolerance) {
+
+                if (settledAt < 0) {
+
+                    settledAt = now;
+                }
+                if (now - settledAt >= R_tuneSettleTime) {
+
+                    break;
+                }
+            }
+            else {
+
+                settledAt = -1;
+            }
+        }
+        //Penalties grow with how far the curve is from meeting its bounds,
+        //which gives the search a way back toward curves that do.
+        if (settledAt < 0) {
+
+            total += R_tuneTimeout + R_tunePenalty * (1 + std::abs(remaining) / curve.tolerance);
+        }
+        else {
+
+            total += settledAt;
+        }
+        double overshootBound = overshootTolerances * curve.tolerance;
+        if (overshoot > overshootBound) {
+
+            total += R_tunePenalty * (overshoot - overshootBound) / curve.tolerance;
+        }
+    }
+    return total / family.starts.size();
+}
+
+std::vector<double> toPoint(const SpeedCurve &curve) {
+
+    return {curve.firstEndBehaviorAt, curve.firstEndBehaviorSpeed, curve.secondEndBehaviorAt, curve.secondEndBehaviorSpeed};
+}
+
+SpeedCurve fromPoint(const SpeedCurve &base, const std::vector<double> &point) {
+
+    return {base.tolerance, point[0], point[1], point[2], point[3]};
+}
+
+//Minimizes the function from the supplied starting point with Nelder-Mead,
+//using the standard coefficients.
+std::vector<double> nelderMead(const std::function<double(const std::vector<double>&)> &function, const std::vector<double> &start) {
+
+    const int dimensions = start.size();
+    std::vector<std::vector<double>> simplex(dimensions + 1, start);
+    for (int d = 0; d < dimensions; ++d) {
+
+        simplex[d + 1][d] = start[d] != 0 ? start[d] * 1.25 : .05;
+    }
+    std::vector<double> values(dimensions + 1);
+    for (int v = 0; v <= dimensions; ++v) {
+
+        values[v] = function(simplex[v]);
+    }
+
+    auto blend = [](const std::vector<double> &a, const std::vector<double> &b, const double t) {
+
+        std::vector<double> result(a.size());
+        for (unsigned int d = 0; d < a.size(); ++d) {
+
+            result[d] = a[d] + t * (b[d] - a[d]);
+        }
+        return result;
+    };
+
+    for (int iteration = 0; iteration < R_tuneIterations; ++iteration) {
+
+        std::vector<int> order(dimensions + 1);
+        for (int v = 0; v <= dimensions; ++v) {
+
+            order[v] = v;
+        }
+        std::sort(order.begin(), order.end(), [&values](const int a, const int b) {return values[a] < values[b];});
+        int best = order[0];
+        int worst = order[dimensions];
+        int secondWorst = order[dimensions - 1];
+        if (std::abs(values[worst] - values[best]) < 1e-9) {
+
+            break;
+        }
+
+        std::vector<double> centroid(dimensions, 0);
+        for (int v = 0; v <= dimensions; ++v) {
+
+            if (v == worst) {
+
+                continue;
+            }
+            for (int d = 0; d < dimensions; ++d) {
+
+                centroid[d] += simplex[v][d] / dimensions;
+            }
+        }
+
+        std::vector<double> reflected = blend(centroid, simplex[worst], -1);
+        double reflectedValue = function(reflected);
+        if (reflectedValue < values[best]) {
+
+            std::vector<double> expanded = blend(centroid, simplex[worst], -2);
+            double expandedValue = function(expanded);
+            if (expandedValue < reflectedValue) {
+
+                simplex[worst] = expanded;
+                values[worst] = expandedValue;
+            }
+            else {
+
+                simplex[worst] = reflected;
+                values[worst] = reflectedValue;
+            }
+        }
+        else if (reflectedValue < values[secondWorst]) {
+
+            simplex[worst] = reflected;
+            values[worst] = reflectedValue;
+        }
+        else {
+
+            std::vector<double> contracted = blend(centroid, simplex[worst], .5);
+            double contractedValue = function(contracted);
+            if (contractedValue < values[worst]) {
+
+                simplex[worst] = contracted;
+                values[worst] = contractedValue;
+            }
+            else {
+
+                //Nothing along this line helps, so close in on the best.
+                for (int v = 0; v <= dimensions; ++v) {
+
+                    if (v != best) {
+
+                        simplex[v] = blend(simplex[best], simplex[v], .5);
+                        values[v] = function(simplex[v]);
+                    }
+                }
+            }
+        }
+    }
+    int best = std::min_element(values.begin(), values.end()) - values.begin();
+    return simplex[best];
+}
+
+SpeedCurve tune(const Family &family, const double overshootTolerances) {
+
+    auto function = [&](const std::vector<double> &point) {
+
+        return score(family, fromPoint(family.curve, point), overshootTolerances);
+    };
+    std::vector<double> best = toPoint(family.curve);
+    double bestValue = function(best);
+    std::cerr << family.name << ": hand-picked scores " << bestValue << std::endl;
+    //The score has plateaus where a curve is penalized, so search from the
+    //hand-picked curve with its breakpoints and speeds scaled as well, and
+    //restart each search from where it ended until it stops improving.
+    for (double breakpoints : {1., 2., 4.}) {
+
+        for (double speeds : {.5, 1., 2.}) {
+
+            std::vector<double> start = toPoint(family.curve);
+            start[0] *= breakpoints;
+            start[1] *= speeds;
+            start[2] *= breakpoints;
+            start[3] *= speeds;
+            double startValue = function(start);
+            for (int restart = 0; restart < R_tuneRestarts; ++restart) {
+
+                std::vector<double> found = nelderMead(function, start);
+                double foundValue = function(found);
+                if (foundValue >= startValue - 1e-6) {
+
+                    break;
+                }
+                start = found;
+                startValue = foundValue;
+            }
+            if (startValue < bestValue) {
+
+                best = start;
+                bestValue = startValue;
+            }
+        }
+    }
+    std::cerr << family.name << ": tuned scores " << bestValue << std::endl;
+    return fromPoint(family.curve, best);
+}
+
+std::string format(const double value) {
+
+    std::ostringstream out;
+    out << std::setprecision(4) << value;
+    return out.str();
+}
+
+//The tolerance is written back as it is, never tuned.
+void writeFamily(std::ostream &out, const std::string &comment, const std::string &prefix, const std::string &calculation, const double tolerance, const SpeedCurve &curve) {
+
+    out << comment << '\n';
+    out << "const double " << prefix << "Tolerance = " << format(tolerance) << ";\n";
+    out << "const double " << prefix << calculation << "FirstEndBehaviorAt = " << format(curve.firstEndBehaviorAt) << ";\n";
+    out << "const double " << prefix << calculation << "FirstEndBehaviorSpeed = " << format(curve.firstEndBehaviorSpeed) << ";\n";
+    out << "const double " << prefix << calculation << "SecondEndBehaviorAt = " << format(curve.secondEndBehaviorAt) << ";\n";
+    out << "const double " << prefix << calculation << "SecondEndBehaviorSpeed = " << format(curve.secondEndBehaviorSpeed) << ";\n";
+}
+
+int main(int argc, char **argv) {
+
+    double overshootTolerances = 1;
+    std::string outputPath = "src/main/include/SpeedCurveConstants.h";
+    for (int i = 1; i < argc; ++i) {
+
+        std::string argument = argv[i];
+        if (argument == "--overshoot" && i + 1 < argc) {
+
+            overshootTolerances = std::stod(argv[++i]);
+        }
+        else if (argument == "--out" && i + 1 < argc) {
+
+            outputPath = argv[++i];
+        }
+        else {
+
+            std::cerr << "Usage: TuneSpeedCurves [--overshoot <tolerances>] [--out <header>]" << std::endl;
+            return 1;
+        }
+    }
+
+    //Every module turns toward the same angle, in motor rotations.
+    Family assumePosition;
+    assumePosition.name = "AssumePosition";
+    assumePosition.curve = R_speedCurveAssumePosition;
+    assumePosition.starts = {.5, 1.5, 4.5, 9, -13.5};
+    assumePosition.begin = [](SwervePlant&, const double &start) {
+
+        return start;
+    };
+    assumePosition.step = [](SwervePlant &plant, const double &remaining, const double &speed) {
+
+        double before = plant.getSteerPosition(0);
+        for (int k = 0; k < 4; ++k) {
+
+            plant.setModuleOutputs(k, 0, speed);
+        }
+        plant.update(R_simLoopPeriod);
+        return remaining - (plant.getSteerPosition(0) - before);
+    };
+
+    //The chassis turns in place toward a heading, in degrees.
+    auto turnInPlace = [](SwervePlant &plant, const double &remaining, const double &speed) {
+
+        double before = plant.getPose().heading;
+        plant.driveChassis(0, 0, speed);
+        plant.update(R_simLoopPeriod);
+        return remaining - (plant.getPose().heading - before);
+    };
+    auto turnInPlaceBegin = [](SwervePlant &plant, const double &start) {
+
+        //Point the modules for turning first, as they would already be
+        //while driving.
+        for (int tick = 0; tick < 25; ++tick) {
+
+            plant.driveChassis(0, 0, 1e-6);
+            plant.update(R_simLoopPeriod);
+        }
+        plant.reset({0, 0, plant.getPose().heading});
+        return start;
+    };
+
+    Family limelightLock;
+    limelightLock.name = "LimelightLock";
+    limelightLock.curve = R_speedCurveLimelightLock;
+    limelightLock.starts = {1, 3, 8, 15, -25};
+    limelightLock.begin = turnInPlaceBegin;
+    limelightLock.step = turnInPlace;
+
+    Family holdAngle;
+    holdAngle.name = "HoldAngle";
+    holdAngle.curve = R_speedCurveHoldAngle;
+    holdAngle.starts = {2, 6, 12, -30};
+    holdAngle.begin = turnInPlaceBegin;
+    holdAngle.step = turnInPlace;
+
+    SpeedCurve tunedAssumePosition = tune(assumePosition, overshootTolerances);
+    SpeedCurve tunedLimelightLock = tune(limelightLock, overshootTolerances);
+    SpeedCurve tunedHoldAngle = tune(holdAngle, overshootTolerances);
+
+    std::ofstream output(outputPath, std::ios::out | std::ios::trunc);
+    if (!output.is_open()) {
+
+        std::cerr << "Unable to open " << outputPath << std::endl;
+        return 1;
+    }
+    output << "//SpeedCurveConstants: The tolerances, end behavior breakpoints, and speeds of\n";
+    output << "//Zion's speed curves (see SpeedCurve.h). Generated by TuneSpeedCurves against\n";
+    output << "//the simulation's plants, allowing overshoot of " << format(overshootTolerances) << " tolerance(s).\n";
+    output << "//Regenerate rather than editing by hand.\n";
+    output << "\n";
+    output << "#pragma once\n";
+    output << "\n";
+    writeFamily(output, "//For assuming a position, in motor rotations.", "R_swerveTrainAssumePosition", "SpeedCalculation", R_swerveTrainAssumePositionTolerance, tunedAssumePosition);
+    output << "\n";
+    writeFamily(output, "//For locking on to the Limelight's target, in degrees. The curve is tuned to stop\n//within R_zionAutoToleranceHorizontalOffset, which R_speedCurveLimelightLock uses\n//in place of this tolerance.", "R_swerveTrainLimelightLock", "PositionSpeedCalculaton", R_swerveTrainLimelightLockTolerance, tunedLimelightLock);
+    output << "\n";
+    writeFamily(output, "//For holding an angle, in degrees.", "R_swerveTrainHoldAngle", "SpeedCalculaton", R_swerveTrainHoldAngleTolerance, tunedHoldAngle);
+    std::cerr << "Wrote " << outputPath << std::endl;
+    return 0;
+}